@@ -8,6 +8,35 @@
 #include <queue>
 #include <stack>
 #include <stdexcept>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <type_traits>
+
+#include "graph-io.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
 using namespace std;
 
@@ -42,13 +71,23 @@ public:
     virtual bool hasEdge(int source, int destination) const = 0;
     virtual std::vector<int> getNeighbors(int vertex) const = 0;
     virtual void printGraph() const = 0;
+
+    // Mutations: remove an edge, append a vertex (returns its id), and remove a
+    // vertex with all its edges. removeVertex renumbers the last vertex to the
+    // removed id so ids stay dense.
+    virtual void removeEdge(int source, int destination) = 0;
+    virtual int addVertex() = 0;
+    virtual void removeVertex(int vertex) = 0;
 };
 
 //-------------------- ADJACENCY MATRIX IMPLEMENTATION --------------------
 class AdjacencyMatrixGraph : public Graph
 {
 private:
+    // capacity x capacity; only the top-left numVertices x numVertices part is in use
+    // and everything outside it is kept false
     std::vector<std::vector<bool>> matrix;
+    int capacity;
 
 public:
     // Constructor: Initialize matrix with given size
@@ -57,6 +96,61 @@ public:
         // TODO: Initialize the adjacency matrix
         // Hint: Create a numVertices x numVertices matrix initialized with false
         matrix = vector <vector<bool>> (vertices, vector<bool> (vertices, false));
+        capacity = vertices;
+    }
+
+    // Remove the edge from source to destination (both directions if undirected). O(1)
+    void removeEdge(int source, int destination) override
+    {
+        if (source < 0 || source >= numVertices || destination < 0 || destination >= numVertices) {
+            return;
+        }
+
+        matrix[source][destination] = false;
+        if (!isDirected()) {
+            matrix[destination][source] = false;
+        }
+    }
+
+    // Append an isolated vertex. The matrix capacity doubles when full, so the
+    // O(capacity^2) regrowth is amortized to O(V) per added vertex.
+    int addVertex() override
+    {
+        if (numVertices == capacity) {
+            int newCapacity = std::max(1, capacity * 2);
+            for (vector <bool> &row : matrix) {
+                row.resize(newCapacity, false);
+            }
+            matrix.resize(newCapacity, vector<bool> (newCapacity, false));
+            capacity = newCapacity;
+        }
+
+        return numVertices++;
+    }
+
+    // Remove a vertex: the last vertex's row and column move into its slot. O(V)
+    void removeVertex(int vertex) override
+    {
+        if (vertex < 0 || vertex >= numVertices) {
+            return;
+        }
+
+        int last = numVertices - 1;
+        if (vertex != last) {
+            // Row first, then column: matrix[vertex][vertex] ends up as matrix[last][last]
+            for (int j = 0; j < numVertices; j++) {
+                matrix[vertex][j] = matrix[last][j];
+            }
+            for (int i = 0; i < numVertices; i++) {
+                matrix[i][vertex] = matrix[i][last];
+            }
+        }
+
+        for (int i = 0; i < numVertices; i++) {
+            matrix[last][i] = false;
+            matrix[i][last] = false;
+        }
+        numVertices--;
     }
 
     // Add an edge from source to destination
@@ -147,6 +241,29 @@ public:
         adjacencyList = vector <vector<int>> (vertices);
     }
 
+    // Build the adjacency list directly from CSR rows, skipping the per-edge
+    // duplicate scan in addEdge. Rows are expected to be deduplicated already
+    // (see buildCSR); an undirected graph expects a symmetrized CSR.
+    static AdjacencyListGraph fromCSR(const CSRData &csr, bool isDirected = false)
+    {
+        AdjacencyListGraph graph(csr.numVertices, isDirected);
+
+        for (int v = 0; v < csr.numVertices; v++) {
+            graph.adjacencyList[v].assign(csr.targets.begin() + csr.offsets[v],
+                                          csr.targets.begin() + csr.offsets[v + 1]);
+        }
+
+        return graph;
+    }
+
+    // Load an edge file (SNAP, DIMACS, Matrix Market or binary) into an adjacency list
+    static AdjacencyListGraph fromFile(const std::string &path, bool isDirected = false,
+                                       EdgeFileFormat format = EdgeFileFormat::Auto)
+    {
+        EdgeList edges = EdgeListLoader::load(path, format);
+        return fromCSR(buildCSR(edges, !isDirected || edges.symmetric), isDirected);
+    }
+
     // Add an edge from source to destination
     void addEdge(int source, int destination) override
     {
@@ -186,6 +303,32 @@ public:
         }
     }
 
+private:
+    // Swap-remove `target` from the row of `vertex` (if present)
+    void eraseFromRow(int vertex, int target)
+    {
+        vector <int> &row = adjacencyList[vertex];
+        for (size_t i = 0; i < row.size(); i++) {
+            if (row[i] == target) {
+                row[i] = row.back();
+                row.pop_back();
+                return;
+            }
+        }
+    }
+
+    // Replace `from` with `to` in the row of `vertex` (if present)
+    void renameInRow(int vertex, int from, int to)
+    {
+        for (int &neighbor : adjacencyList[vertex]) {
+            if (neighbor == from) {
+                neighbor = to;
+                return;
+            }
+        }
+    }
+
+public:
     // Check if there is an edge from source to destination
     bool hasEdge(int source, int destination) const override
     {
@@ -219,6 +362,104 @@ public:
         return adjacencyList[vertex];
     }
 
+    // Remove the edge from source to destination (both directions if undirected).
+    // Swap-removes inside the row, so it costs O(degree).
+    void removeEdge(int source, int destination) override
+    {
+        if (source < 0 || source >= numVertices || destination < 0 || destination >= numVertices) {
+            return;
+        }
+
+        eraseFromRow(source, destination);
+        if (!isDirected()) {
+            eraseFromRow(destination, source);
+        }
+    }
+
+    // Append an isolated vertex. Amortized O(1)
+    int addVertex() override
+    {
+        adjacencyList.emplace_back();
+        return numVertices++;
+    }
+
+    // Remove a vertex and its edges; the last vertex takes over its id.
+    // Undirected graphs only touch the rows of the two vertices' neighbors,
+    // O(sum of their degrees); directed graphs have no incoming lists, so edges
+    // into the vertex are found with one O(V + E) scan.
+    void removeVertex(int vertex) override
+    {
+        if (vertex < 0 || vertex >= numVertices) {
+            return;
+        }
+
+        int last = numVertices - 1;
+
+        if (!isDirected()) {
+            for (int neighbor : adjacencyList[vertex]) {
+                if (neighbor != vertex) {
+                    eraseFromRow(neighbor, vertex);
+                }
+            }
+            adjacencyList[vertex].clear();
+
+            if (vertex != last) {
+                adjacencyList[vertex].swap(adjacencyList[last]);
+                for (int neighbor : adjacencyList[vertex]) {
+                    renameInRow(neighbor == last ? vertex : neighbor, last, vertex);
+                }
+            }
+        } else {
+            adjacencyList[vertex].clear();
+            if (vertex != last) {
+                adjacencyList[vertex].swap(adjacencyList[last]);
+            }
+            for (int u = 0; u < last; u++) {
+                eraseFromRow(u, vertex);
+                if (vertex != last) {
+                    renameInRow(u, last, vertex);
+                }
+            }
+        }
+
+        adjacencyList.pop_back();
+        numVertices--;
+    }
+
+    // Row of a vertex without copying it (no bounds check; for hot loops)
+    const std::vector<int> &neighbors(int vertex) const
+    {
+        return adjacencyList[vertex];
+    }
+
+    // Flatten the adjacency list into CSR arrays, each row sorted by target
+    // (binary files written from it can feed the sorted-row CSR kernels)
+    CSRData toCSR() const
+    {
+        CSRData csr;
+        csr.numVertices = numVertices;
+        csr.offsets.assign(numVertices + 1, 0);
+
+        for (int v = 0; v < numVertices; v++) {
+            csr.offsets[v + 1] = csr.offsets[v] + adjacencyList[v].size();
+        }
+
+        csr.targets.reserve(csr.offsets[numVertices]);
+        for (int v = 0; v < numVertices; v++) {
+            csr.targets.insert(csr.targets.end(), adjacencyList[v].begin(), adjacencyList[v].end());
+            std::sort(csr.targets.begin() + csr.offsets[v], csr.targets.end());
+        }
+
+        return csr;
+    }
+
+    // Write the graph in the binary graph format (see graph-io.h)
+    void saveBinary(const std::string &path) const
+    {
+        CSRData csr = toCSR();
+        writeBinaryGraph(path, viewOf(csr), isDirected());
+    }
+
     // Print the adjacency list
     void printGraph() const override
     {
@@ -242,318 +483,3353 @@ public:
     }
 };
 
-//-------------------- GRAPH TRAVERSAL ALGORITHMS --------------------
-class GraphAlgorithms
+//-------------------- READ-ONLY CSR IMPLEMENTATION --------------------
+// Graph over CSR arrays that are not owned by the graph, typically a memory-mapped
+// binary graph file. Loading costs only the mmap and header checks; all
+// GraphAlgorithms run on it directly. Mutations are rejected.
+class CSRGraph : public Graph
 {
+private:
+    CSRView csr;
+    std::shared_ptr<const MappedBinaryGraph> mapping; // Keeps the mapped file alive
+
 public:
-    // Depth-First Search (DFS) implementation
-    static void DFS(const Graph &graph, int startVertex, std::vector<bool> &visited)
+    CSRGraph(const CSRView &view, bool isDirected) : Graph(view.numVertices, isDirected), csr(view) {}
+
+    // Map a binary graph file written by AdjacencyListGraph::saveBinary
+    static CSRGraph open(const std::string &path, bool verifyChecksum = true)
     {
-        // TODO: Implement DFS
-        // 1. Mark startVertex as visited
-        // 2. For each unvisited neighbor of startVertex, recursively call DFS
-        visited[startVertex] = true;
+        auto mapped = std::make_shared<const MappedBinaryGraph>(path, verifyChecksum);
+        CSRGraph graph(mapped->view(), mapped->isDirected());
+        graph.mapping = mapped;
+        return graph;
+    }
 
-        for (int neighbor : graph.getNeighbors(startVertex)) {
-            if (!visited[neighbor]) {
-                DFS(graph, neighbor, visited);
-            }
-        }
+    const CSRView &view() const
+    {
+        return csr;
+    }
 
-        // Hint: Use the following structure
+    void addEdge(int /*source*/, int /*destination*/) override
+    {
+        throw std::logic_error("CSRGraph is read-only");
     }
 
-    // Iterative DFS using a stack
-    static void DFSIterative(const Graph &graph, int startVertex)
+    void removeEdge(int /*source*/, int /*destination*/) override
     {
-        // TODO: Implement iterative DFS using a stack
-        // 1. Create a stack and push startVertex
-        // 2. Create a visited array initialized to false
-        // 3. While stack is not empty:
-        //    a. Pop a vertex from stack
-        //    b. If not visited, mark as visited and process it
-        //    c. Push all unvisited neighbors to stack
-        stack <int> store;
-        vector <bool> visited (graph.getNumVertices(), false);
+        throw std::logic_error("CSRGraph is read-only");
+    }
 
-        store.push(startVertex);
+    int addVertex() override
+    {
+        throw std::logic_error("CSRGraph is read-only");
+    }
 
-        while (!store.empty()) {
-            int current = store.top();
-            store.pop();
+    void removeVertex(int /*vertex*/) override
+    {
+        throw std::logic_error("CSRGraph is read-only");
+    }
 
-            if (!visited[current]) {
-                visited[current] = true;
-                cout << current << " ";
+    bool hasEdge(int source, int destination) const override
+    {
+        if (source < 0 || source >= numVertices || destination < 0 || destination >= numVertices) {
+            return false;
+        }
 
-                for (int neighbor : graph.getNeighbors(current)) {
-                    if (!visited[neighbor]) {
-                        store.push(neighbor);
-                    }
-                }
+        for (int64_t i = csr.offsets[source]; i < csr.offsets[source + 1]; i++) {
+            if (csr.targets[i] == destination) {
+                return true;
             }
         }
+
+        return false;
     }
 
-    // Breadth-First Search (BFS) implementation
-    static void BFS(const Graph &graph, int startVertex)
+    std::vector<int> getNeighbors(int vertex) const override
     {
-        // TODO: Implement BFS
-        // 1. Create a queue and enqueue startVertex
-        // 2. Create a visited array initialized to false
-        // 3. Mark startVertex as visited
-        // 4. While queue is not empty:
-        //    a. Dequeue a vertex
-        //    b. Process it
-        //    c. Enqueue all unvisited neighbors and mark them as visited
-        queue <int> store;
-        store.push(startVertex);
-        vector <bool> visited (graph.getNumVertices(), false);
-        visited[startVertex] = true;
-
-        while (!store.empty()) {
-            int current = store.front();
-            store.pop();
+        if (vertex < 0 || vertex >= numVertices) {
+            return {};
+        }
 
-            cout << current << " ";
+        return std::vector<int>(csr.targets + csr.offsets[vertex], csr.targets + csr.offsets[vertex + 1]);
+    }
 
-            for (int neighbor : graph.getNeighbors(current)) {
-                if (!visited[neighbor]) {
-                    store.push(neighbor);
-                    visited[neighbor] = true;
+    void printGraph() const override
+    {
+        for (int i = 0; i < numVertices; i++) {
+            cout << i << " -> ";
+            for (int64_t j = csr.offsets[i]; j < csr.offsets[i + 1]; j++) {
+                cout << csr.targets[j];
+                if (j != csr.offsets[i + 1] - 1) {
+                    cout << " -> ";
                 }
             }
+
+            cout << endl;
         }
-        
     }
+};
 
-    // Find connected components in an undirected graph
-    static int findConnectedComponents(const Graph &graph)
+//-------------------- DYNAMIC GRAPH WITH SNAPSHOTS --------------------
+// Adjacency rows are grouped into blocks of BLOCK_SIZE vertices. A version is an
+// immutable array of shared, immutable blocks. Writers copy only the blocks a
+// batch touches (copy-on-write) and publish the new version with an atomic
+// pointer swap, so readers never lock: a snapshot pins one version and sees it
+// unchanged for as long as it is held, while updates keep streaming in.
+class DynamicGraph
+{
+public:
+    struct EdgeUpdate
     {
-        // TODO: Implement connected components finder
-        // 1. Initialize all vertices as unvisited
-        // 2. For each unvisited vertex, run DFS and count it as a new component
-        // 3. Return the total count of components
-        int countComponents = 0;
-
-        vector <bool> visited (graph.getNumVertices(), false);
+        int source;
+        int destination;
+        bool insert; // false = delete
+    };
 
-        for (int i = 0; i < graph.getNumVertices(); i++) {
-            if (!visited[i]) {
-                DFS (graph, i, visited);
-                countComponents++;
-            }
-        }
+private:
+    static const int BLOCK_SIZE = 64;
 
-        return countComponents; // Placeholder
-    }
+    struct Block
+    {
+        std::vector<int> rows[BLOCK_SIZE];
+    };
 
-    // Check if a graph is bipartite
-    static bool isBipartite(const Graph &graph)
+    struct Version
     {
-        // TODO: Implement bipartite check using BFS
-        // 1. Initialize all vertices with no color (-1)
-        // 2. Start BFS from any vertex, coloring it with 0
-        // 3. For each neighbor, color it with the opposite color (1-color)
-        // 4. If any adjacent vertices have the same color, return false
-        // 5. If all vertices can be colored without conflicts, return true
-        vector <int> color (graph.getNumVertices(), -1);
-
-        for (int i = 0; i < graph.getNumVertices(); i++) {
-            if (color[i] == -1) {
-                queue <int> q;
-                q.push(i);
-                
-                color[i] = 0;
-
-                while (!q.empty()) {
-                    int current = q.front();
-                    q.pop();
-
-                    for (int neighbor : graph.getNeighbors(current)) {
-                        if (color[neighbor] == -1) {
-                            color[neighbor] = 1 - color[current];
-                            q.push(neighbor);
-                        } else if (color[neighbor] == color[current]) {
-                            return false;
-                        }
-                    }
-                }
-            }
+        uint64_t number;
+        int numVertices;
+        std::vector<std::shared_ptr<const Block>> blocks;
+
+        const std::vector<int> &row(int vertex) const
+        {
+            return blocks[vertex / BLOCK_SIZE]->rows[vertex % BLOCK_SIZE];
         }
+    };
 
-        return true; // Placeholder
-    }
+    bool directed;
+    std::shared_ptr<const Version> current; // Only touched through std::atomic_load / atomic_store
 
-    // Find shortest path between two vertices (unweighted graph)
-    static std::vector<int> findShortestPath(const Graph &graph, int startVertex, int endVertex)
+    // Group commit: concurrent writers queue their batches, and whoever holds
+    // writeMutex applies everything queued so far as one new version
+    std::mutex writeMutex;
+    std::mutex pendingMutex;
+    std::vector<EdgeUpdate> pending;
+    int pendingNewVertices = 0;
+    uint64_t enqueuedTickets = 0;
+    uint64_t committedTickets = 0; // Guarded by writeMutex
+
+    static std::shared_ptr<const Block> emptyBlock()
     {
-        // TODO: Implement shortest path finder using BFS
-        // 1. Run BFS from startVertex
-        // 2. Keep track of parent/previous vertex for each visited vertex
-        // 3. Once endVertex is reached, reconstruct the path by following parents backwards
-        // 4. Return the path (or empty vector if no path exists)
-        vector <bool> visited (graph.getNumVertices(), false);
-        vector <int> parent (graph.getNumVertices(), -1);
+        static const std::shared_ptr<const Block> empty = std::make_shared<const Block>();
+        return empty;
+    }
 
-        queue <int> q;
-        q.push(startVertex);
-        visited[startVertex] = true;
+    // Build and publish a new version containing `updates`
+    void commit(const std::vector<EdgeUpdate> &updates, int newVertices)
+    {
+        std::shared_ptr<const Version> base = std::atomic_load(&current);
+        auto next = std::make_shared<Version>(*base); // Copies block pointers only
+        next->number = base->number + 1;
+        next->numVertices = base->numVertices + newVertices;
+        next->blocks.resize((next->numVertices + BLOCK_SIZE - 1) / BLOCK_SIZE, emptyBlock());
 
-        while (!q.empty()) {
-            int current = q.front();
-            q.pop();
+        // Blocks already copied for this version (nullptr = still shared with `base`)
+        std::vector<Block *> owned(next->blocks.size(), nullptr);
+        auto mutableRow = [&](int vertex) -> std::vector<int> & {
+            int b = vertex / BLOCK_SIZE;
+            if (!owned[b]) {
+                auto copy = std::make_shared<Block>(*next->blocks[b]);
+                owned[b] = copy.get();
+                next->blocks[b] = copy;
+            }
+            return owned[b]->rows[vertex % BLOCK_SIZE];
+        };
 
-            if (current == endVertex) {
-                break;
+        auto insertArc = [&](int u, int v) {
+            std::vector<int> &row = mutableRow(u);
+            if (std::find(row.begin(), row.end(), v) == row.end()) {
+                row.push_back(v);
             }
+        };
+        auto eraseArc = [&](int u, int v) {
+            std::vector<int> &row = mutableRow(u);
+            auto it = std::find(row.begin(), row.end(), v);
+            if (it != row.end()) {
+                *it = row.back();
+                row.pop_back();
+            }
+        };
 
-            for (int neighbor : graph.getNeighbors(current)) {
-                if (!visited[neighbor]) {
-                    visited[neighbor] = true;
-                    parent[neighbor] = current;
-                    q.push(neighbor);
-                }
+        for (const EdgeUpdate &update : updates) {
+            int u = update.source, v = update.destination;
+            if (u < 0 || u >= next->numVertices || v < 0 || v >= next->numVertices) {
+                continue;
+            }
+            if (update.insert) {
+                insertArc(u, v);
+                if (!directed) insertArc(v, u);
+            } else {
+                eraseArc(u, v);
+                if (!directed) eraseArc(v, u);
             }
         }
 
-        vector <int> path;
+        std::atomic_store(&current, std::shared_ptr<const Version>(std::move(next)));
+    }
 
-        if (!visited[endVertex]) {
-            return path;
+    uint64_t enqueueAndCommit(const std::vector<EdgeUpdate> &updates, int newVertices)
+    {
+        uint64_t ticket;
+        {
+            std::lock_guard<std::mutex> lock(pendingMutex);
+            pending.insert(pending.end(), updates.begin(), updates.end());
+            pendingNewVertices += newVertices;
+            ticket = ++enqueuedTickets;
         }
 
-        for (int v = endVertex; v != -1; v = parent[v]) {
-            path.push_back(v);
+        std::lock_guard<std::mutex> lock(writeMutex);
+        if (committedTickets < ticket) {
+            std::vector<EdgeUpdate> work;
+            int workVertices;
+            uint64_t upTo;
+            {
+                std::lock_guard<std::mutex> pendingLock(pendingMutex);
+                work.swap(pending);
+                workVertices = pendingNewVertices;
+                pendingNewVertices = 0;
+                upTo = enqueuedTickets;
+            }
+            commit(work, workVertices);
+            committedTickets = upTo;
         }
-
-        return path; // Placeholder
+        return std::atomic_load(&current)->number;
     }
 
-    static void topoDFS(const Graph &graph, int v, std::vector<bool> &visited, std::stack<int> &s) {
-        visited[v] = true;
+public:
+    // Read-only Graph over one pinned version; all GraphAlgorithms run on it
+    class Snapshot : public Graph
+    {
+    private:
+        std::shared_ptr<const Version> version;
 
-        for (int neighbor : graph.getNeighbors(v)) {
-            if (!visited[neighbor]) {
-                topoDFS(graph, neighbor, visited, s);
-            }
-        }
+    public:
+        Snapshot(std::shared_ptr<const Version> pinned, bool isDirected)
+            : Graph(pinned->numVertices, isDirected), version(std::move(pinned)) {}
 
-        s.push(v);
+        uint64_t versionNumber() const
+        {
+            return version->number;
+        }
+
+        void addEdge(int /*source*/, int /*destination*/) override
+        {
+            throw std::logic_error("DynamicGraph snapshots are read-only");
+        }
+
+        void removeEdge(int /*source*/, int /*destination*/) override
+        {
+            throw std::logic_error("DynamicGraph snapshots are read-only");
+        }
+
+        int addVertex() override
+        {
+            throw std::logic_error("DynamicGraph snapshots are read-only");
+        }
+
+        void removeVertex(int /*vertex*/) override
+        {
+            throw std::logic_error("DynamicGraph snapshots are read-only");
+        }
+
+        bool hasEdge(int source, int destination) const override
+        {
+            if (source < 0 || source >= numVertices || destination < 0 || destination >= numVertices) {
+                return false;
+            }
+            const std::vector<int> &row = version->row(source);
+            return std::find(row.begin(), row.end(), destination) != row.end();
+        }
+
+        std::vector<int> getNeighbors(int vertex) const override
+        {
+            if (vertex < 0 || vertex >= numVertices) {
+                return {};
+            }
+            return version->row(vertex);
+        }
+
+        void printGraph() const override
+        {
+            for (int i = 0; i < numVertices; i++) {
+                const std::vector<int> &row = version->row(i);
+                cout << i << " -> ";
+                for (size_t j = 0; j < row.size(); j++) {
+                    cout << row[j];
+                    if (j != row.size() - 1) {
+                        cout << " -> ";
+                    }
+                }
+                cout << endl;
+            }
+        }
+    };
+
+    DynamicGraph(int vertices, bool isDirected = false) : directed(isDirected)
+    {
+        auto initial = std::make_shared<Version>();
+        initial->number = 0;
+        initial->numVertices = vertices;
+        initial->blocks.assign((vertices + BLOCK_SIZE - 1) / BLOCK_SIZE, emptyBlock());
+        current = initial;
+    }
+
+    bool isDirected() const
+    {
+        return directed;
+    }
+
+    // Pin the latest published version (wait-free for readers)
+    Snapshot snapshot() const
+    {
+        return Snapshot(std::atomic_load(&current), directed);
+    }
+
+    // Apply a batch of insertions / deletions atomically: a snapshot sees either
+    // none or all of it. Safe to call from many threads; concurrent batches are
+    // coalesced into one version. Returns a version number that includes the batch.
+    uint64_t applyBatch(const std::vector<EdgeUpdate> &updates)
+    {
+        return enqueueAndCommit(updates, 0);
+    }
+
+    // Append `count` isolated vertices; returns a version number that includes them
+    uint64_t addVertices(int count)
+    {
+        return enqueueAndCommit({}, count);
+    }
+
+    uint64_t addEdge(int source, int destination)
+    {
+        return applyBatch({{source, destination, true}});
+    }
+
+    uint64_t removeEdge(int source, int destination)
+    {
+        return applyBatch({{source, destination, false}});
+    }
+};
+
+//-------------------- SHARED PARALLEL AND CSR HELPERS --------------------
+// Run body(begin, end, worker) over [0, count) in chunks of `grain` items.
+// Small inputs run inline so short BFS levels do not pay for thread start-up.
+template <class Body>
+inline void parallelFor(size_t count, unsigned numThreads, size_t grain, Body body)
+{
+    unsigned workers = (unsigned)std::min<size_t>(numThreads, (count + grain - 1) / grain);
+    if (workers <= 1) {
+        body((size_t)0, count, 0u);
+        return;
+    }
+
+    std::atomic<size_t> nextChunk (0);
+    auto worker = [&](unsigned index) {
+        for (size_t begin = nextChunk.fetch_add(grain); begin < count; begin = nextChunk.fetch_add(grain)) {
+            body(begin, std::min(count, begin + grain), index);
+        }
+    };
+
+    vector <std::thread> threads;
+    for (unsigned t = 1; t < workers; t++) {
+        threads.emplace_back(worker, t);
+    }
+    worker(0);
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+}
+
+inline unsigned resolveThreads(unsigned numThreads)
+{
+    return numThreads ? numThreads : std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Neighbors in both directions, rows sorted (undirected view of the graph)
+inline CSRData symmetricCSR(const Graph &graph)
+{
+    EdgeList edges;
+    edges.numVertices = graph.getNumVertices();
+    for (int u = 0; u < graph.getNumVertices(); u++) {
+        for (int v : graph.getNeighbors(u)) {
+            edges.sources.push_back(u);
+            edges.targets.push_back(v);
+        }
+    }
+
+    return buildCSR(edges, true);
+}
+
+//-------------------- BITSET COLORING ENGINE --------------------
+// Bipartiteness (2-coloring with an odd-cycle witness) and general k-coloring
+// (parallel Jones-Plassmann, sequential largest-degree-first greedy).
+// Both work on the undirected view of the graph flattened to CSR, and worker
+// threads share visited / uncolored state through atomic bitmaps.
+class GraphColoring
+{
+private:
+    // One bit per vertex; word updates are atomic so threads can share it
+    class AtomicBitmap
+    {
+    private:
+        std::vector<std::atomic<uint64_t>> words;
+
+    public:
+        explicit AtomicBitmap(size_t bits, bool value = false) : words((bits + 63) / 64)
+        {
+            for (size_t i = 0; i < words.size(); i++) {
+                words[i].store(value ? ~0ull : 0ull, std::memory_order_relaxed);
+            }
+        }
+
+        bool test(size_t bit) const
+        {
+            return (words[bit >> 6].load(std::memory_order_relaxed) >> (bit & 63)) & 1;
+        }
+
+        // Set the bit; true if this call was the one that set it
+        bool testAndSet(size_t bit)
+        {
+            uint64_t mask = 1ull << (bit & 63);
+            return !(words[bit >> 6].fetch_or(mask, std::memory_order_relaxed) & mask);
+        }
+
+        void reset(size_t bit)
+        {
+            words[bit >> 6].fetch_and(~(1ull << (bit & 63)), std::memory_order_relaxed);
+        }
+    };
+
+    static CSRData undirectedCSR(const Graph &graph)
+    {
+        EdgeList edges;
+        edges.numVertices = graph.getNumVertices();
+        for (int u = 0; u < graph.getNumVertices(); u++) {
+            for (int v : graph.getNeighbors(u)) {
+                edges.sources.push_back(u);
+                edges.targets.push_back(v);
+            }
+        }
+
+        // Rows of an undirected Graph are already symmetric and duplicate-free
+        return buildCSR(edges, graph.isDirected(), graph.isDirected());
+    }
+
+public:
+    // 2-color the graph with a level-synchronous BFS per component.
+    // Returns true with color[v] in {0, 1} if the graph is bipartite. Otherwise
+    // returns false and fills `oddCycle` with an odd cycle v0 - v1 - ... - v0:
+    // the conflicting edge joins two vertices on the same BFS level, and their
+    // tree paths up to the common ancestor close the cycle.
+    static bool twoColor(const Graph &graph, std::vector<int> &color, std::vector<int> &oddCycle,
+                         unsigned numThreads = 0)
+    {
+        CSRData csr = undirectedCSR(graph);
+        return twoColor(viewOf(csr), color, oddCycle, numThreads);
+    }
+
+    // Same on CSR arrays that already hold both directions of every edge
+    // (e.g. a mapped undirected CSRGraph), skipping the conversion
+    static bool twoColor(const CSRView &csr, std::vector<int> &color, std::vector<int> &oddCycle,
+                         unsigned numThreads = 0)
+    {
+        numThreads = resolveThreads(numThreads);
+        int n = csr.numVertices;
+
+        vector <int> level (n, -1), parent (n, -1);
+        AtomicBitmap visited (n);
+        vector <vector<int>> next (numThreads);
+        vector <int> frontier;
+
+        for (int root = 0; root < n; root++) {
+            if (!visited.testAndSet(root)) {
+                continue;
+            }
+            level[root] = 0;
+            frontier.assign(1, root);
+
+            while (!frontier.empty()) {
+                parallelFor(frontier.size(), numThreads, 4096, [&](size_t begin, size_t end, unsigned t) {
+                    for (size_t i = begin; i < end; i++) {
+                        int u = frontier[i];
+                        for (int64_t e = csr.offsets[u]; e < csr.offsets[u + 1]; e++) {
+                            int v = csr.targets[e];
+                            if (visited.testAndSet(v)) {
+                                parent[v] = u;
+                                level[v] = level[u] + 1;
+                                next[t].push_back(v);
+                            }
+                        }
+                    }
+                });
+
+                frontier.clear();
+                for (vector <int> &part : next) {
+                    frontier.insert(frontier.end(), part.begin(), part.end());
+                    part.clear();
+                }
+            }
+        }
+
+        // BFS levels of adjacent vertices differ by at most one, so an edge is
+        // monochromatic exactly when both ends sit on the same level
+        std::atomic<int64_t> conflict (-1);
+        parallelFor(n, numThreads, 16384, [&](size_t begin, size_t end, unsigned) {
+            for (size_t u = begin; u < end && conflict.load(std::memory_order_relaxed) == -1; u++) {
+                for (int64_t e = csr.offsets[u]; e < csr.offsets[u + 1]; e++) {
+                    if (level[csr.targets[e]] == level[u]) {
+                        int64_t expected = -1;
+                        conflict.compare_exchange_strong(expected, e);
+                        break;
+                    }
+                }
+            }
+        });
+
+        color.assign(n, 0);
+        oddCycle.clear();
+        for (int v = 0; v < n; v++) {
+            color[v] = level[v] & 1;
+        }
+
+        int64_t edge = conflict.load();
+        if (edge == -1) {
+            return true;
+        }
+
+        int u = (int)(std::upper_bound(csr.offsets, csr.offsets + n + 1, edge) - csr.offsets) - 1;
+        int v = csr.targets[edge];
+        if (u == v) {
+            oddCycle.push_back(u); // Self-loop
+            return false;
+        }
+
+        // Climb from both ends in lockstep until the tree paths meet
+        vector <int> left, right;
+        while (u != v) {
+            left.push_back(u);
+            right.push_back(v);
+            u = parent[u];
+            v = parent[v];
+        }
+        oddCycle.push_back(u);
+        oddCycle.insert(oddCycle.end(), left.rbegin(), left.rend());
+        oddCycle.insert(oddCycle.end(), right.begin(), right.end());
+        return false;
+    }
+
+    // Jones-Plassmann coloring: every vertex gets a random priority; in each round,
+    // all uncolored vertices whose priority beats every uncolored neighbor take the
+    // smallest color unused by their colored neighbors. Those vertices are pairwise
+    // non-adjacent, so a round runs fully in parallel. Returns the number of colors.
+    static int jonesPlassmann(const Graph &graph, std::vector<int> &color, unsigned numThreads = 0)
+    {
+        CSRData csr = undirectedCSR(graph);
+        return jonesPlassmann(viewOf(csr), color, numThreads);
+    }
+
+    // Same on CSR arrays that already hold both directions of every edge
+    static int jonesPlassmann(const CSRView &csr, std::vector<int> &color, unsigned numThreads = 0)
+    {
+        numThreads = resolveThreads(numThreads);
+        int n = csr.numVertices;
+
+        auto priority = [](uint64_t v) {
+            // splitmix64 finalizer: a cheap, deterministic random permutation of ids
+            v += 0x9E3779B97F4A7C15ull;
+            v = (v ^ (v >> 30)) * 0xBF58476D1CE4E5B9ull;
+            v = (v ^ (v >> 27)) * 0x94D049BB133111EBull;
+            return v ^ (v >> 31);
+        };
+
+        int64_t maxDegree = 0;
+        for (int v = 0; v < n; v++) {
+            maxDegree = std::max(maxDegree, csr.degree(v));
+        }
+
+        color.assign(n, -1);
+        AtomicBitmap uncolored (n, true);
+        vector <int> remaining (n);
+        for (int v = 0; v < n; v++) {
+            remaining[v] = v;
+        }
+
+        // Per-worker scratch: forbidden[c] == stamp means color c is taken by a neighbor
+        vector <vector<int>> forbidden (numThreads, vector<int>(maxDegree + 2, -1));
+        vector <vector<int>> chosen (numThreads);
+        vector <int> stamp (numThreads, 0);
+
+        while (!remaining.empty()) {
+            parallelFor(remaining.size(), numThreads, 2048, [&](size_t begin, size_t end, unsigned t) {
+                for (size_t i = begin; i < end; i++) {
+                    int v = remaining[i];
+                    uint64_t mine = priority(v);
+                    bool isLocalMax = true;
+                    for (int64_t e = csr.offsets[v]; e < csr.offsets[v + 1] && isLocalMax; e++) {
+                        int u = csr.targets[e];
+                        if (u != v && uncolored.test(u)) {
+                            uint64_t theirs = priority(u);
+                            isLocalMax = theirs < mine || (theirs == mine && u < v);
+                        }
+                    }
+                    if (!isLocalMax) {
+                        continue;
+                    }
+
+                    int current = ++stamp[t];
+                    for (int64_t e = csr.offsets[v]; e < csr.offsets[v + 1]; e++) {
+                        int u = csr.targets[e];
+                        if (!uncolored.test(u)) {
+                            forbidden[t][color[u]] = current;
+                        }
+                    }
+                    int c = 0;
+                    while (forbidden[t][c] == current) {
+                        c++;
+                    }
+                    color[v] = c;
+                    chosen[t].push_back(v);
+                }
+            });
+
+            // Publish this round's colors only after every worker has finished reading
+            for (vector <int> &part : chosen) {
+                for (int v : part) {
+                    uncolored.reset(v);
+                }
+                part.clear();
+            }
+            remaining.erase(std::remove_if(remaining.begin(), remaining.end(),
+                                           [&](int v) { return !uncolored.test(v); }),
+                            remaining.end());
+        }
+
+        return n == 0 ? 0 : *std::max_element(color.begin(), color.end()) + 1;
+    }
+
+    // Sequential greedy coloring in largest-degree-first order. Returns the number of colors.
+    static int greedy(const Graph &graph, std::vector<int> &color)
+    {
+        CSRData csr = undirectedCSR(graph);
+        int n = csr.numVertices;
+
+        vector <int> order (n);
+        for (int v = 0; v < n; v++) {
+            order[v] = v;
+        }
+        std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return csr.degree(a) > csr.degree(b); });
+
+        color.assign(n, -1);
+        vector <int> forbidden (n + 1, -1);
+        int numColors = 0;
+        for (int v : order) {
+            for (int64_t e = csr.offsets[v]; e < csr.offsets[v + 1]; e++) {
+                if (color[csr.targets[e]] != -1) {
+                    forbidden[color[csr.targets[e]]] = v;
+                }
+            }
+            int c = 0;
+            while (forbidden[c] == v) {
+                c++;
+            }
+            color[v] = c;
+            numColors = std::max(numColors, c + 1);
+        }
+
+        return numColors;
+    }
+
+    // True if no edge (ignoring self-loops) joins two vertices of the same color
+    static bool isValidColoring(const Graph &graph, const std::vector<int> &color)
+    {
+        for (int u = 0; u < graph.getNumVertices(); u++) {
+            for (int v : graph.getNeighbors(u)) {
+                if (u != v && color[u] == color[v]) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+};
+
+//-------------------- VISITOR-BASED TRAVERSAL ENGINE --------------------
+// Base visitor with no-op callbacks. Derive from it and hide only the callbacks
+// you need; the engines are templates over the visitor type, so the calls are
+// resolved at compile time and inline into the traversal loop.
+struct TraversalVisitor
+{
+    // First time a vertex is reached (BFS: enqueued, DFS: entered)
+    void discoverVertex(int /*vertex*/) {}
+    // Every edge source -> target scanned from a discovered vertex
+    void examineEdge(int /*source*/, int /*target*/) {}
+    // All edges of the vertex have been examined (DFS: post-order)
+    void finishVertex(int /*vertex*/) {}
+    // Return true to stop the traversal early (checked once per vertex)
+    bool done() const { return false; }
+};
+
+// BFS / DFS engines over any Graph. AdjacencyListGraph and CSRGraph rows are
+// read in place; other graph types fall back to getNeighbors.
+class TraversalEngine
+{
+private:
+    struct Row
+    {
+        const int *first;
+        const int *last;
+
+        const int *begin() const { return first; }
+        const int *end() const { return last; }
+    };
+
+    static const std::vector<int> &adjacency(const AdjacencyListGraph &graph, int vertex)
+    {
+        return graph.neighbors(vertex);
+    }
+
+    static Row adjacency(const CSRGraph &graph, int vertex)
+    {
+        const CSRView &csr = graph.view();
+        return {csr.targets + csr.offsets[vertex], csr.targets + csr.offsets[vertex + 1]};
+    }
+
+    static std::vector<int> adjacency(const Graph &graph, int vertex)
+    {
+        return graph.getNeighbors(vertex);
+    }
+
+    static const int *rowBegin(const std::vector<int> &row)
+    {
+        return row.data();
+    }
+
+    static const int *rowBegin(const Row &row)
+    {
+        return row.first;
+    }
+
+public:
+    // Call fn(graph) with the most specific graph type the engines have a fast path for
+    template <class Fn>
+    static void dispatch(const Graph &graph, Fn fn)
+    {
+        if (const AdjacencyListGraph *list = dynamic_cast<const AdjacencyListGraph *>(&graph)) {
+            fn(*list);
+        } else if (const CSRGraph *csr = dynamic_cast<const CSRGraph *>(&graph)) {
+            fn(*csr);
+        } else {
+            fn(graph);
+        }
+    }
+
+    // BFS from `start`, skipping vertices already marked in `visited` (which it
+    // updates, so several calls can share it to cover a whole graph)
+    template <class GraphT, class Visitor>
+    static void breadthFirst(const GraphT &graph, int start, Visitor &visitor, std::vector<char> &visited)
+    {
+        if (start < 0 || start >= graph.getNumVertices() || visited[start]) {
+            return;
+        }
+
+        vector <int> queue;
+        visited[start] = 1;
+        queue.push_back(start);
+        visitor.discoverVertex(start);
+
+        for (size_t head = 0; head < queue.size() && !visitor.done(); head++) {
+            int current = queue[head];
+            for (int neighbor : adjacency(graph, current)) {
+                visitor.examineEdge(current, neighbor);
+                if (!visited[neighbor]) {
+                    visited[neighbor] = 1;
+                    queue.push_back(neighbor);
+                    visitor.discoverVertex(neighbor);
+                }
+            }
+            visitor.finishVertex(current);
+        }
+    }
+
+    template <class GraphT, class Visitor>
+    static void breadthFirst(const GraphT &graph, int start, Visitor &visitor)
+    {
+        vector <char> visited (graph.getNumVertices(), 0);
+        breadthFirst(graph, start, visitor, visited);
+    }
+
+    // DFS from `start` with an explicit frame stack: neighbors are explored in
+    // adjacency order, finishVertex fires in post-order
+    template <class GraphT, class Visitor>
+    static void depthFirst(const GraphT &graph, int start, Visitor &visitor, std::vector<char> &visited)
+    {
+        if (start < 0 || start >= graph.getNumVertices() || visited[start]) {
+            return;
+        }
+
+        struct Frame
+        {
+            int vertex;
+            const int *cursor;
+            const int *last;
+        };
+
+        // Rows read in place are referenced directly; getNeighbors copies are
+        // kept alive alongside their frames
+        using RowT = decltype(adjacency(graph, start));
+        constexpr bool copiesRows = !std::is_reference<RowT>::value && std::is_same<RowT, std::vector<int>>::value;
+        vector <Frame> frames;
+        vector <vector<int>> ownedRows;
+
+        auto enter = [&](int vertex) {
+            visited[vertex] = 1;
+            visitor.discoverVertex(vertex);
+            if constexpr (copiesRows) {
+                ownedRows.push_back(adjacency(graph, vertex));
+                const vector <int> &row = ownedRows.back();
+                frames.push_back({vertex, row.data(), row.data() + row.size()});
+            } else {
+                const auto &row = adjacency(graph, vertex);
+                frames.push_back({vertex, rowBegin(row), rowBegin(row) + (row.end() - row.begin())});
+            }
+        };
+
+        enter(start);
+        while (!frames.empty() && !visitor.done()) {
+            Frame &top = frames.back();
+            if (top.cursor != top.last) {
+                int neighbor = *top.cursor++;
+                visitor.examineEdge(top.vertex, neighbor);
+                if (!visited[neighbor]) {
+                    enter(neighbor);
+                }
+            } else {
+                visitor.finishVertex(top.vertex);
+                frames.pop_back();
+                if constexpr (copiesRows) {
+                    ownedRows.pop_back();
+                }
+            }
+        }
+    }
+
+    template <class GraphT, class Visitor>
+    static void depthFirst(const GraphT &graph, int start, Visitor &visitor)
+    {
+        vector <char> visited (graph.getNumVertices(), 0);
+        depthFirst(graph, start, visitor, visited);
+    }
+};
+
+//-------------------- GRAPH TRAVERSAL ALGORITHMS --------------------
+class GraphAlgorithms
+{
+private:
+    // Prints vertices in the order they are discovered
+    struct PrintVisitor : TraversalVisitor
+    {
+        void discoverVertex(int vertex)
+        {
+            cout << vertex << " ";
+        }
+    };
+
+public:
+    // Depth-First Search (DFS) implementation
+    static void DFS(const Graph &graph, int startVertex, std::vector<bool> &visited)
+    {
+        // TODO: Implement DFS
+        // 1. Mark startVertex as visited
+        // 2. For each unvisited neighbor of startVertex, recursively call DFS
+        visited[startVertex] = true;
+
+        for (int neighbor : graph.getNeighbors(startVertex)) {
+            if (!visited[neighbor]) {
+                DFS(graph, neighbor, visited);
+            }
+        }
+
+        // Hint: Use the following structure
+    }
+
+    // Iterative DFS using a stack
+    static void DFSIterative(const Graph &graph, int startVertex)
+    {
+        // TODO: Implement iterative DFS using a stack
+        // 1. Create a stack and push startVertex
+        // 2. Create a visited array initialized to false
+        // 3. While stack is not empty:
+        //    a. Pop a vertex from stack
+        //    b. If not visited, mark as visited and process it
+        //    c. Push all unvisited neighbors to stack
+        // Printing is the visitor's job; the engine itself does no I/O
+        PrintVisitor printer;
+        TraversalEngine::dispatch(graph, [&](const auto &g) {
+            TraversalEngine::depthFirst(g, startVertex, printer);
+        });
+    }
+
+    // Breadth-First Search (BFS) implementation
+    static void BFS(const Graph &graph, int startVertex)
+    {
+        // TODO: Implement BFS
+        // 1. Create a queue and enqueue startVertex
+        // 2. Create a visited array initialized to false
+        // 3. Mark startVertex as visited
+        // 4. While queue is not empty:
+        //    a. Dequeue a vertex
+        //    b. Process it
+        //    c. Enqueue all unvisited neighbors and mark them as visited
+        PrintVisitor printer;
+        TraversalEngine::dispatch(graph, [&](const auto &g) {
+            TraversalEngine::breadthFirst(g, startVertex, printer);
+        });
+    }
+
+    // Find connected components in an undirected graph
+    static int findConnectedComponents(const Graph &graph)
+    {
+        // TODO: Implement connected components finder
+        // 1. Initialize all vertices as unvisited
+        // 2. For each unvisited vertex, run DFS and count it as a new component
+        // 3. Return the total count of components
+        int countComponents = 0;
+
+        // Iterative engine instead of the recursive DFS so large loaded graphs
+        // do not overflow the call stack; the no-op visitor compiles away
+        vector <char> visited (graph.getNumVertices(), 0);
+        TraversalVisitor visitor;
+
+        TraversalEngine::dispatch(graph, [&](const auto &g) {
+            for (int i = 0; i < g.getNumVertices(); i++) {
+                if (!visited[i]) {
+                    TraversalEngine::breadthFirst(g, i, visitor, visited);
+                    countComponents++;
+                }
+            }
+        });
+
+        return countComponents; // Placeholder
+    }
+
+    // Check if a graph is bipartite
+    static bool isBipartite(const Graph &graph)
+    {
+        // TODO: Implement bipartite check using BFS
+        // 1. Initialize all vertices with no color (-1)
+        // 2. Start BFS from any vertex, coloring it with 0
+        // 3. For each neighbor, color it with the opposite color (1-color)
+        // 4. If any adjacent vertices have the same color, return false
+        // 5. If all vertices can be colored without conflicts, return true
+        // The coloring engine runs the BFS level by level on shared bitmaps
+        // and also reports the coloring or an odd cycle; use it directly for those.
+        vector <int> color, oddCycle;
+        return GraphColoring::twoColor(graph, color, oddCycle);
+    }
+
+    // Find shortest path between two vertices (unweighted graph)
+    static std::vector<int> findShortestPath(const Graph &graph, int startVertex, int endVertex)
+    {
+        // TODO: Implement shortest path finder using BFS
+        // 1. Run BFS from startVertex
+        // 2. Keep track of parent/previous vertex for each visited vertex
+        // 3. Once endVertex is reached, reconstruct the path by following parents backwards
+        // 4. Return the path (or empty vector if no path exists)
+        int n = graph.getNumVertices();
+        if (startVertex < 0 || startVertex >= n || endVertex < 0 || endVertex >= n) {
+            return {};
+        }
+
+        vector <bool> visited (graph.getNumVertices(), false);
+        vector <int> parent (graph.getNumVertices(), -1);
+
+        queue <int> q;
+        q.push(startVertex);
+        visited[startVertex] = true;
+
+        while (!q.empty()) {
+            int current = q.front();
+            q.pop();
+
+            if (current == endVertex) {
+                break;
+            }
+
+            for (int neighbor : graph.getNeighbors(current)) {
+                if (!visited[neighbor]) {
+                    visited[neighbor] = true;
+                    parent[neighbor] = current;
+                    q.push(neighbor);
+                }
+            }
+        }
+
+        vector <int> path;
+
+        if (!visited[endVertex]) {
+            return path;
+        }
+
+        for (int v = endVertex; v != -1; v = parent[v]) {
+            path.push_back(v);
+        }
+        std::reverse(path.begin(), path.end());
+
+        return path; // Placeholder
+    }
+
+    // Bidirectional BFS for point-to-point queries: grow the smaller of the two
+    // search frontiers one level at a time until they meet. Explores roughly
+    // 2 * b^(d/2) vertices instead of b^d. `reversedGraph` provides incoming edges
+    // (pass the graph itself when it is undirected). Returns the path from
+    // startVertex to endVertex, or an empty vector if none exists.
+    static std::vector<int> findShortestPathBidirectional(const Graph &graph, const Graph &reversedGraph,
+                                                          int startVertex, int endVertex)
+    {
+        int n = graph.getNumVertices();
+        if (startVertex < 0 || startVertex >= n || endVertex < 0 || endVertex >= n) {
+            return {};
+        }
+        if (startVertex == endVertex) {
+            return {startVertex};
+        }
+
+        // Per side: hop distance (-1 = unseen) and the neighbor it was reached from
+        vector <int> distance[2] = {vector<int>(n, -1), vector<int>(n, -1)};
+        vector <int> parent[2] = {vector<int>(n, -1), vector<int>(n, -1)};
+        vector <int> frontier[2] = {{startVertex}, {endVertex}};
+        const Graph *edges[2] = {&graph, &reversedGraph};
+        distance[0][startVertex] = 0;
+        distance[1][endVertex] = 0;
+
+        int best = -1, meetFrom = -1, meetTo = -1;
+
+        while (!frontier[0].empty() && !frontier[1].empty()) {
+            int side = frontier[0].size() <= frontier[1].size() ? 0 : 1;
+            int other = 1 - side;
+            vector <int> next;
+
+            // Expand the whole level so the best meeting edge of this level is found
+            for (int u : frontier[side]) {
+                for (int v : edges[side]->getNeighbors(u)) {
+                    if (distance[other][v] != -1) {
+                        int length = distance[side][u] + 1 + distance[other][v];
+                        if (best == -1 || length < best) {
+                            best = length;
+                            meetFrom = side == 0 ? u : v;
+                            meetTo = side == 0 ? v : u;
+                        }
+                    }
+                    if (distance[side][v] == -1) {
+                        distance[side][v] = distance[side][u] + 1;
+                        parent[side][v] = u;
+                        next.push_back(v);
+                    }
+                }
+            }
+
+            if (best != -1) {
+                break;
+            }
+            frontier[side].swap(next);
+        }
+
+        vector <int> path;
+        if (best == -1) {
+            return path;
+        }
+
+        // start ... meetFrom from the forward tree, then meetTo ... end from the backward tree
+        for (int v = meetFrom; v != -1; v = parent[0][v]) {
+            path.push_back(v);
+        }
+        std::reverse(path.begin(), path.end());
+        for (int v = meetTo; v != -1; v = parent[1][v]) {
+            path.push_back(v);
+        }
+
+        return path;
+    }
+
+    // Convenience overload; for directed graphs this builds the reversed graph on
+    // every call, so prefer the overload above when answering many queries.
+    static std::vector<int> findShortestPathBidirectional(const Graph &graph, int startVertex, int endVertex)
+    {
+        if (!graph.isDirected()) {
+            return findShortestPathBidirectional(graph, graph, startVertex, endVertex);
+        }
+
+        AdjacencyListGraph reversedGraph = reverseGraph(graph);
+        return findShortestPathBidirectional(graph, reversedGraph, startVertex, endVertex);
+    }
+
+    // Multi-source BFS: hop distance from every vertex to its nearest source, and
+    // which source that is (-1 / -1 when unreachable). One O(V + E) pass answers
+    // "nearest facility" for all vertices at once.
+    static void multiSourceBFS(const Graph &graph, const std::vector<int> &sources,
+                               std::vector<int> &distance, std::vector<int> &nearestSource)
+    {
+        vector <int> parent;
+        multiSourceSearch(graph, sources, -1, distance, nearestSource, parent);
+    }
+
+    // Shortest path from the nearest of `sources` to `target` (source first, target
+    // last); stops as soon as the target is reached. Empty if no source reaches it.
+    static std::vector<int> findPathFromNearestSource(const Graph &graph, const std::vector<int> &sources, int target)
+    {
+        if (target < 0 || target >= graph.getNumVertices()) {
+            return {};
+        }
+
+        vector <int> distance, nearestSource, parent;
+        multiSourceSearch(graph, sources, target, distance, nearestSource, parent);
+
+        vector <int> path;
+        if (distance[target] == -1) {
+            return path;
+        }
+        for (int v = target; v != -1; v = parent[v]) {
+            path.push_back(v);
+        }
+        std::reverse(path.begin(), path.end());
+        return path;
+    }
+
+    // Shared multi-source BFS; stops once `target` is discovered (-1 = run to completion)
+    static void multiSourceSearch(const Graph &graph, const std::vector<int> &sources, int target,
+                                  std::vector<int> &distance, std::vector<int> &nearestSource,
+                                  std::vector<int> &parent)
+    {
+        int n = graph.getNumVertices();
+        distance.assign(n, -1);
+        nearestSource.assign(n, -1);
+        parent.assign(n, -1);
+
+        vector <int> queue;
+        queue.reserve(n);
+        for (int source : sources) {
+            if (source >= 0 && source < n && distance[source] == -1) {
+                distance[source] = 0;
+                nearestSource[source] = source;
+                queue.push_back(source);
+            }
+        }
+
+        if (target != -1 && distance[target] != -1) {
+            return;
+        }
+
+        for (size_t head = 0; head < queue.size(); head++) {
+            int current = queue[head];
+            for (int neighbor : graph.getNeighbors(current)) {
+                if (distance[neighbor] == -1) {
+                    distance[neighbor] = distance[current] + 1;
+                    nearestSource[neighbor] = nearestSource[current];
+                    parent[neighbor] = current;
+                    if (neighbor == target) {
+                        return;
+                    }
+                    queue.push_back(neighbor);
+                }
+            }
+        }
+    }
+
+    // Topological sort (for directed acyclic graphs)
+    // Returns an empty vector when the graph has a cycle; use topologicalSortKahn
+    // to also get the offending cycle.
+    static std::vector<int> topologicalSort(const Graph &graph)
+    {
+        vector <int> topoOrder;
+
+        if (!topologicalSortKahn(graph, topoOrder)) {
+            return {};
+        }
+
+        return topoOrder;
+    }
+
+    // Kahn's algorithm: repeatedly remove vertices with in-degree 0.
+    // Returns false if some vertices are never freed, i.e. the graph has a cycle;
+    // in that case `cycle` (if given) receives one directed cycle v0 -> v1 -> ... -> v0.
+    static bool topologicalSortKahn(const Graph &graph, std::vector<int> &order, std::vector<int> *cycle = nullptr)
+    {
+        int n = graph.getNumVertices();
+        vector <int> inDegree (n, 0);
+
+        for (int u = 0; u < n; u++) {
+            for (int v : graph.getNeighbors(u)) {
+                inDegree[v]++;
+            }
+        }
+
+        // `order` doubles as the FIFO queue: [head, order.size()) are ready vertices
+        order.clear();
+        order.reserve(n);
+        for (int v = 0; v < n; v++) {
+            if (inDegree[v] == 0) {
+                order.push_back(v);
+            }
+        }
+
+        for (size_t head = 0; head < order.size(); head++) {
+            for (int v : graph.getNeighbors(order[head])) {
+                if (--inDegree[v] == 0) {
+                    order.push_back(v);
+                }
+            }
+        }
+
+        if ((int)order.size() == n) {
+            return true;
+        }
+
+        if (cycle) {
+            *cycle = extractCycle(graph, inDegree);
+        }
+        return false;
+    }
+
+    // Level-wise topological sort: levels[k] holds every vertex whose longest path
+    // from a source has k edges, so all vertices of one level can run concurrently.
+    // Each wavefront is expanded by up to `numThreads` workers (0 = hardware
+    // concurrency) that decrement in-degrees atomically.
+    // Returns false (with `cycle` filled when given) if the graph has a cycle.
+    static bool topologicalLevels(const Graph &graph, std::vector<std::vector<int>> &levels,
+                                  unsigned numThreads = 0, std::vector<int> *cycle = nullptr)
+    {
+        int n = graph.getNumVertices();
+        std::vector<std::atomic<int>> inDegree (n);
+        for (int v = 0; v < n; v++) {
+            inDegree[v].store(0, std::memory_order_relaxed);
+        }
+        for (int u = 0; u < n; u++) {
+            for (int v : graph.getNeighbors(u)) {
+                inDegree[v].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        if (numThreads == 0) {
+            numThreads = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        levels.clear();
+        vector <int> frontier;
+        for (int v = 0; v < n; v++) {
+            if (inDegree[v].load(std::memory_order_relaxed) == 0) {
+                frontier.push_back(v);
+            }
+        }
+
+        int placed = 0;
+        const size_t minVerticesPerThread = 1024;
+
+        while (!frontier.empty()) {
+            placed += frontier.size();
+
+            unsigned workers = (unsigned)std::min<size_t>(numThreads, std::max<size_t>(1, frontier.size() / minVerticesPerThread));
+            vector <vector<int>> next (workers);
+
+            auto expand = [&](unsigned t) {
+                size_t begin = frontier.size() * t / workers, end = frontier.size() * (t + 1) / workers;
+                for (size_t i = begin; i < end; i++) {
+                    for (int v : graph.getNeighbors(frontier[i])) {
+                        if (inDegree[v].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                            next[t].push_back(v);
+                        }
+                    }
+                }
+            };
+
+            vector <std::thread> threads;
+            for (unsigned t = 1; t < workers; t++) {
+                threads.emplace_back(expand, t);
+            }
+            expand(0);
+            for (std::thread &thread : threads) {
+                thread.join();
+            }
+
+            levels.push_back(std::move(frontier));
+            frontier.clear();
+            for (vector <int> &part : next) {
+                frontier.insert(frontier.end(), part.begin(), part.end());
+            }
+        }
+
+        if (placed == n) {
+            return true;
+        }
+
+        if (cycle) {
+            vector <int> remaining (n);
+            for (int v = 0; v < n; v++) {
+                remaining[v] = inDegree[v].load(std::memory_order_relaxed);
+            }
+            *cycle = extractCycle(graph, remaining);
+        }
+        return false;
+    }
+
+    // Run task(v) for every vertex, level by level: vertices of one wavefront run
+    // concurrently on up to `numThreads` workers, and a level starts only after the
+    // previous one has finished (all its dependencies are done).
+    template <class Task>
+    static void runWavefronts(const std::vector<std::vector<int>> &levels, Task task, unsigned numThreads = 0)
+    {
+        if (numThreads == 0) {
+            numThreads = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        for (const vector <int> &level : levels) {
+            std::atomic<size_t> nextIndex (0);
+            auto worker = [&]() {
+                for (size_t i = nextIndex.fetch_add(1); i < level.size(); i = nextIndex.fetch_add(1)) {
+                    task(level[i]);
+                }
+            };
+
+            unsigned workers = (unsigned)std::min<size_t>(numThreads, level.size());
+            vector <std::thread> threads;
+            for (unsigned t = 1; t < workers; t++) {
+                threads.emplace_back(worker);
+            }
+            worker();
+            for (std::thread &thread : threads) {
+                thread.join();
+            }
+        }
+    }
+
+    // Given in-degrees left over by Kahn's algorithm (> 0 exactly for vertices that
+    // were never freed), return one directed cycle. Every leftover vertex has a
+    // leftover predecessor, so walking predecessors must eventually repeat a vertex.
+    static std::vector<int> extractCycle(const Graph &graph, const std::vector<int> &remainingInDegree)
+    {
+        int n = graph.getNumVertices();
+        vector <int> predecessor (n, -1);
+        int start = -1;
+
+        for (int u = 0; u < n; u++) {
+            if (remainingInDegree[u] == 0) {
+                continue;
+            }
+            start = u;
+            for (int v : graph.getNeighbors(u)) {
+                if (remainingInDegree[v] > 0) {
+                    predecessor[v] = u;
+                }
+            }
+        }
+
+        if (start == -1) {
+            return {};
+        }
+
+        // Walk back until a vertex repeats; the repeated vertex lies on a cycle
+        vector <int> seenAt (n, -1);
+        vector <int> walk;
+        int v = start;
+        while (seenAt[v] == -1) {
+            seenAt[v] = walk.size();
+            walk.push_back(v);
+            v = predecessor[v];
+        }
+
+        // walk[seenAt[v]..] follows predecessor links; reverse it into edge direction
+        vector <int> cycle (walk.begin() + seenAt[v], walk.end());
+        std::reverse(cycle.begin(), cycle.end());
+        return cycle;
+    }
+
+    // Helper function for first DFS pass in Kosaraju's algorithm
+    static void kosarajuFirstDFS(const Graph &graph, int vertex, std::vector<bool> &visited,
+                                 std::stack<int> &finishOrder)
+    {
+        // TODO: Implement first DFS pass of Kosaraju's algorithm
+        // 1. Mark current vertex as visited
+        // 2. Recursively visit all unvisited neighbors
+        // 3. After processing all neighbors, push current vertex to finishOrder stack
+        // (This creates a stack with vertices ordered by decreasing finish time)
+        // Iterative with an explicit frame stack so deep graphs do not overflow the call stack
+        struct Frame
+        {
+            int vertex;
+            vector <int> neighbors;
+            size_t next;
+        };
+
+        visited[vertex] = true;
+        vector <Frame> frames;
+        frames.push_back({vertex, graph.getNeighbors(vertex), 0});
+
+        while (!frames.empty()) {
+            Frame &top = frames.back();
+            if (top.next < top.neighbors.size()) {
+                int neighbor = top.neighbors[top.next++];
+                if (!visited[neighbor]) {
+                    visited[neighbor] = true;
+                    frames.push_back({neighbor, graph.getNeighbors(neighbor), 0});
+                }
+            } else {
+                finishOrder.push(top.vertex);
+                frames.pop_back();
+            }
+        }
+    }
+
+    // Helper function for second DFS pass in Kosaraju's algorithm
+    static void kosarajuSecondDFS(const Graph &graph, int vertex, std::vector<bool> &visited,
+                                  std::vector<int> &component)
+    {
+        // TODO: Implement second DFS pass of Kosaraju's algorithm
+        // 1. Mark current vertex as visited
+        // 2. Add current vertex to the current component
+        // 3. Recursively visit all unvisited neighbors
+        // (This identifies vertices in the current strongly connected component)
+        visited[vertex] = true;
+        vector <int> store (1, vertex);
+
+        while (!store.empty()) {
+            int current = store.back();
+            store.pop_back();
+            component.push_back(current);
+
+            for (int neighbor : graph.getNeighbors(current)) {
+                if (!visited[neighbor]) {
+                    visited[neighbor] = true;
+                    store.push_back(neighbor);
+                }
+            }
+        }
+    }
+
+    // Find strongly connected components using Kosaraju's algorithm
+    static std::vector<std::vector<int>> findStronglyConnectedComponents(const Graph &graph)
+    {
+        // TODO: Implement Kosaraju's algorithm for finding SCCs
+        // 1. Check if graph is directed (algorithm only works for directed graphs)
+        // 2. First DFS pass:
+        //    a. For each unvisited vertex, run kosarajuFirstDFS
+        //    b. This fills the stack with vertices in order of decreasing finish times
+        // 3. Create a reversed graph by reversing all edges
+        // 4. Second DFS pass:
+        //    a. Process vertices in order from the stack (decreasing finish time)
+        //    b. For each unvisited vertex, run kosarajuSecondDFS to find a component
+        //    c. Add each component to the result
+        // 5. Return the list of strongly connected components
+        if (!graph.isDirected()) {
+            return {};
+        }
+
+        vector <bool> visited (graph.getNumVertices(), false);
+        stack <int> finishOrder;
+
+        for (int v = 0; v < graph.getNumVertices(); v++) {
+            if (!visited[v]) {
+                kosarajuFirstDFS(graph, v, visited, finishOrder);
+            }
+        }
+
+        AdjacencyListGraph reversedGraph = reverseGraph(graph);
+
+        fill (visited.begin(), visited.end(), false);
+        vector <vector <int>> scc;
+
+        while (!finishOrder.empty()) {
+            int current = finishOrder.top();
+            finishOrder.pop();
+
+            if (!visited[current]) {
+                vector <int> components;
+                kosarajuSecondDFS (reversedGraph, current, visited, components);
+                scc.push_back(components);
+            }
+        }
+
+
+        return scc; // Placeholder
+    }
+
+    // Graph with every edge u -> v turned into v -> u
+    static AdjacencyListGraph reverseGraph(const Graph &graph)
+    {
+        EdgeList edges;
+        edges.numVertices = graph.getNumVertices();
+        for (int u = 0; u < graph.getNumVertices(); u++) {
+            for (int v : graph.getNeighbors(u)) {
+                edges.sources.push_back(v);
+                edges.targets.push_back(u);
+            }
+        }
+
+        return AdjacencyListGraph::fromCSR(buildCSR(edges, false), true);
+    }
+
+private:
+    // Call onMatch(x) for every value present in both sorted, duplicate-free
+    // ranges. The SSE2 path tests a block of four from `a` against all four
+    // rotations of a block of four from `b` (16 comparisons in 4 instructions),
+    // then advances whichever block ends with the smaller value, as a merge would.
+    template <class OnMatch>
+    static void intersectSorted(const int *a, size_t na, const int *b, size_t nb, OnMatch onMatch)
+    {
+        size_t i = 0, j = 0;
+#ifdef __SSE2__
+        while (i + 4 <= na && j + 4 <= nb) {
+            __m128i va = _mm_loadu_si128((const __m128i *)(a + i));
+            __m128i vb = _mm_loadu_si128((const __m128i *)(b + j));
+            __m128i eq01 = _mm_or_si128(_mm_cmpeq_epi32(va, vb),
+                                        _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1))));
+            __m128i eq23 = _mm_or_si128(_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))),
+                                        _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3))));
+            int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_or_si128(eq01, eq23)));
+            for (int lane = 0; mask; lane++, mask >>= 1) {
+                if (mask & 1) {
+                    onMatch(a[i + lane]);
+                }
+            }
+
+            int lastA = a[i + 3], lastB = b[j + 3];
+            if (lastA <= lastB) {
+                i += 4;
+            }
+            if (lastB <= lastA) {
+                j += 4;
+            }
+        }
+#endif
+        while (i < na && j < nb) {
+            if (a[i] < b[j]) {
+                i++;
+            } else if (b[j] < a[i]) {
+                j++;
+            } else {
+                onMatch(a[i]);
+                i++;
+                j++;
+            }
+        }
+    }
+
+    // Keep every undirected edge once, pointing from the lower- to the higher-ranked
+    // end (rank = degree, ties broken by id). Each vertex then keeps O(sqrt(m))
+    // neighbors, which bounds the intersection work around hubs. Rows stay sorted
+    // by id since they are subsequences of the sorted symmetric rows.
+    static CSRData orientByDegree(const CSRView &csr, unsigned numThreads)
+    {
+        int n = csr.numVertices;
+        auto lowerRank = [&](int u, int v) {
+            return csr.degree(u) < csr.degree(v) || (csr.degree(u) == csr.degree(v) && u < v);
+        };
+
+        CSRData oriented;
+        oriented.numVertices = n;
+        oriented.offsets.assign(n + 1, 0);
+        parallelFor(n, numThreads, 4096, [&](size_t begin, size_t end, unsigned) {
+            for (size_t u = begin; u < end; u++) {
+                for (int64_t e = csr.offsets[u]; e < csr.offsets[u + 1]; e++) {
+                    oriented.offsets[u + 1] += lowerRank((int)u, csr.targets[e]);
+                }
+            }
+        });
+        for (int v = 0; v < n; v++) {
+            oriented.offsets[v + 1] += oriented.offsets[v];
+        }
+
+        oriented.targets.resize(oriented.offsets[n]);
+        parallelFor(n, numThreads, 4096, [&](size_t begin, size_t end, unsigned) {
+            for (size_t u = begin; u < end; u++) {
+                int64_t slot = oriented.offsets[u];
+                for (int64_t e = csr.offsets[u]; e < csr.offsets[u + 1]; e++) {
+                    if (lowerRank((int)u, csr.targets[e])) {
+                        oriented.targets[slot++] = csr.targets[e];
+                    }
+                }
+                // Input rows may come in any order; intersections need them sorted
+                std::sort(oriented.targets.begin() + oriented.offsets[u], oriented.targets.begin() + slot);
+            }
+        });
+        return oriented;
+    }
+
+    // Degree without the self-loop (rows are duplicate-free, so at most one)
+    static int simpleDegree(const CSRView &csr, int v)
+    {
+        const int *begin = csr.targets + csr.offsets[v], *end = csr.targets + csr.offsets[v + 1];
+        return (int)(end - begin) - (std::find(begin, end, v) != end ? 1 : 0);
+    }
+
+public:
+    // Number of triangles in the undirected view of the graph
+    static int64_t countTriangles(const Graph &graph, unsigned numThreads = 0)
+    {
+        CSRData csr = symmetricCSR(graph);
+        return countTriangles(viewOf(csr), numThreads);
+    }
+
+    // Same on CSR arrays that already hold both directions of every edge with
+    // duplicate-free rows in any order (buildCSR output or a mapped undirected CSRGraph)
+    static int64_t countTriangles(const CSRView &csr, unsigned numThreads = 0)
+    {
+        numThreads = resolveThreads(numThreads);
+        CSRData oriented = orientByDegree(csr, numThreads);
+        std::atomic<int64_t> total (0);
+
+        // Every triangle u < v < w (in rank order) is found exactly once, at u via v
+        parallelFor(csr.numVertices, numThreads, 256, [&](size_t begin, size_t end, unsigned) {
+            int64_t found = 0;
+            for (size_t u = begin; u < end; u++) {
+                const int *uRow = oriented.targets.data() + oriented.offsets[u];
+                size_t uSize = oriented.degree((int)u);
+                for (size_t k = 0; k < uSize; k++) {
+                    int v = uRow[k];
+                    intersectSorted(uRow, uSize, oriented.targets.data() + oriented.offsets[v], oriented.degree(v),
+                                    [&](int) { found++; });
+                }
+            }
+            total.fetch_add(found, std::memory_order_relaxed);
+        });
+        return total.load();
+    }
+
+    // Triangles through each vertex; returns the total number of triangles
+    static int64_t countTriangles(const CSRView &csr, std::vector<int64_t> &perVertex, unsigned numThreads = 0)
+    {
+        numThreads = resolveThreads(numThreads);
+        CSRData oriented = orientByDegree(csr, numThreads);
+        std::vector<std::atomic<int64_t>> counts (csr.numVertices);
+        std::atomic<int64_t> total (0);
+
+        parallelFor(csr.numVertices, numThreads, 256, [&](size_t begin, size_t end, unsigned) {
+            int64_t found = 0;
+            for (size_t u = begin; u < end; u++) {
+                const int *uRow = oriented.targets.data() + oriented.offsets[u];
+                size_t uSize = oriented.degree((int)u);
+                int64_t atU = 0;
+                for (size_t k = 0; k < uSize; k++) {
+                    int v = uRow[k];
+                    int64_t atV = 0;
+                    intersectSorted(uRow, uSize, oriented.targets.data() + oriented.offsets[v], oriented.degree(v),
+                                    [&](int w) {
+                                        atV++;
+                                        counts[w].fetch_add(1, std::memory_order_relaxed);
+                                    });
+                    atU += atV;
+                    if (atV) {
+                        counts[v].fetch_add(atV, std::memory_order_relaxed);
+                    }
+                }
+                counts[u].fetch_add(atU, std::memory_order_relaxed);
+                found += atU;
+            }
+            total.fetch_add(found, std::memory_order_relaxed);
+        });
+
+        perVertex.resize(csr.numVertices);
+        for (int v = 0; v < csr.numVertices; v++) {
+            perVertex[v] = counts[v].load(std::memory_order_relaxed);
+        }
+        return total.load();
+    }
+
+    // Local clustering coefficient of every vertex (triangles through v over the
+    // d(d-1)/2 pairs of its neighbors, 0 when d < 2). Returns the global
+    // coefficient (transitivity): 3 * triangles / connected triples.
+    static double clusteringCoefficients(const Graph &graph, std::vector<double> &local, unsigned numThreads = 0)
+    {
+        CSRData csr = symmetricCSR(graph);
+        return clusteringCoefficients(viewOf(csr), local, numThreads);
+    }
+
+    static double clusteringCoefficients(const CSRView &csr, std::vector<double> &local, unsigned numThreads = 0)
+    {
+        vector <int64_t> triangles;
+        int64_t total = countTriangles(csr, triangles, numThreads);
+
+        int64_t triples = 0;
+        local.assign(csr.numVertices, 0.0);
+        for (int v = 0; v < csr.numVertices; v++) {
+            int64_t d = simpleDegree(csr, v);
+            int64_t pairs = d * (d - 1) / 2;
+            triples += pairs;
+            if (pairs > 0) {
+                local[v] = (double)triangles[v] / pairs;
+            }
+        }
+        return triples ? 3.0 * total / triples : 0.0;
+    }
+
+    // Core number of every vertex (largest k such that v belongs to the k-core,
+    // the maximal subgraph with minimum degree k), by Batagelj-Zaversnik peeling:
+    // vertices are bucket-sorted by degree and removed in increasing order, each
+    // removal moving its higher-degree neighbors down one bucket in O(1).
+    // Returns the degeneracy (the largest core number). O(V + E).
+    static int coreNumbers(const Graph &graph, std::vector<int> &core)
+    {
+        CSRData csr = symmetricCSR(graph);
+        return coreNumbers(viewOf(csr), core);
+    }
+
+    static int coreNumbers(const CSRView &csr, std::vector<int> &core)
+    {
+        int n = csr.numVertices;
+        core.resize(n);
+        int maxDegree = 0;
+        for (int v = 0; v < n; v++) {
+            core[v] = simpleDegree(csr, v);
+            maxDegree = std::max(maxDegree, core[v]);
+        }
+
+        // bucketStart[d]: first slot of degree-d vertices in `order`
+        vector <int> bucketStart (maxDegree + 2, 0), order (n), position (n);
+        for (int v = 0; v < n; v++) {
+            bucketStart[core[v] + 1]++;
+        }
+        for (int d = 0; d <= maxDegree; d++) {
+            bucketStart[d + 1] += bucketStart[d];
+        }
+        vector <int> next (bucketStart.begin(), bucketStart.end() - 1);
+        for (int v = 0; v < n; v++) {
+            position[v] = next[core[v]]++;
+            order[position[v]] = v;
+        }
+
+        int degeneracy = 0;
+        for (int i = 0; i < n; i++) {
+            int v = order[i];
+            degeneracy = std::max(degeneracy, core[v]);
+            for (int64_t e = csr.offsets[v]; e < csr.offsets[v + 1]; e++) {
+                int u = csr.targets[e];
+                if (core[u] <= core[v]) {
+                    continue;
+                }
+
+                // Swap u with the first vertex of its bucket, then shrink the bucket by one
+                int du = core[u];
+                int first = order[bucketStart[du]];
+                if (first != u) {
+                    std::swap(order[position[u]], order[bucketStart[du]]);
+                    std::swap(position[u], position[first]);
+                }
+                bucketStart[du]++;
+                core[u]--;
+            }
+        }
+        return degeneracy;
+    }
+};
+
+//-------------------- VERTEX REORDERING --------------------
+// Renumber vertices so that vertices used together get nearby ids, which makes
+// traversals touch fewer cache lines. Every ordering returns a permutation
+// `newId[oldId]`; relabel() applies it and inverse() maps new ids back to the
+// original ones.
+class VertexReordering
+{
+private:
+    // Convert a visiting order (order[newId] = oldId) into newId[oldId]
+    static std::vector<int> orderToPermutation(const std::vector<int> &order)
+    {
+        return inverse(order);
+    }
+
+public:
+    // Reverse Cuthill-McKee: BFS from a low-degree (pseudo-peripheral) vertex of each
+    // component, visiting neighbors by increasing degree, then reverse the whole order.
+    // Keeps the bandwidth of the adjacency matrix small.
+    static std::vector<int> reverseCuthillMcKee(const Graph &graph)
+    {
+        CSRData csr = symmetricCSR(graph);
+        int n = csr.numVertices;
+
+        vector <int> byDegree (n);
+        for (int v = 0; v < n; v++) {
+            byDegree[v] = v;
+        }
+        std::stable_sort(byDegree.begin(), byDegree.end(),
+                         [&](int a, int b) { return csr.degree(a) < csr.degree(b); });
+
+        vector <bool> visited (n, false);
+        vector <int> order;
+        order.reserve(n);
+        vector <int> row;
+
+        for (int start : byDegree) {
+            if (visited[start]) {
+                continue;
+            }
+
+            // Move to a pseudo-peripheral vertex: the lowest-degree vertex of the last
+            // BFS level, repeated while the eccentricity keeps growing
+            int root = start, eccentricity = -1;
+            for (int attempt = 0; attempt < 4; attempt++) {
+                vector <int> level (1, root);
+                vector <int> seen (1, root);
+                visited[root] = true;
+                int depth = 0;
+                vector <int> lastLevel = level;
+                while (!level.empty()) {
+                    lastLevel = level;
+                    vector <int> nextLevel;
+                    for (int u : level) {
+                        for (int64_t i = csr.offsets[u]; i < csr.offsets[u + 1]; i++) {
+                            int v = csr.targets[i];
+                            if (!visited[v]) {
+                                visited[v] = true;
+                                seen.push_back(v);
+                                nextLevel.push_back(v);
+                            }
+                        }
+                    }
+                    level.swap(nextLevel);
+                    depth++;
+                }
+                for (int v : seen) {
+                    visited[v] = false;
+                }
+
+                int candidate = *std::min_element(lastLevel.begin(), lastLevel.end(),
+                                                  [&](int a, int b) { return csr.degree(a) < csr.degree(b); });
+                if (depth <= eccentricity) {
+                    break;
+                }
+                eccentricity = depth;
+                root = candidate;
+            }
+
+            // Cuthill-McKee BFS from the chosen root
+            size_t head = order.size();
+            order.push_back(root);
+            visited[root] = true;
+            for (; head < order.size(); head++) {
+                int u = order[head];
+                row.clear();
+                for (int64_t i = csr.offsets[u]; i < csr.offsets[u + 1]; i++) {
+                    if (!visited[csr.targets[i]]) {
+                        visited[csr.targets[i]] = true;
+                        row.push_back(csr.targets[i]);
+                    }
+                }
+                std::stable_sort(row.begin(), row.end(),
+                                 [&](int a, int b) { return csr.degree(a) < csr.degree(b); });
+                order.insert(order.end(), row.begin(), row.end());
+            }
+        }
+
+        std::reverse(order.begin(), order.end());
+        return orderToPermutation(order);
+    }
+
+    // Degree sort: highest-degree vertices first, so the hot hub rows and their
+    // per-vertex state share a few cache lines
+    static std::vector<int> degreeSort(const Graph &graph)
+    {
+        int n = graph.getNumVertices();
+        vector <int> degree (n, 0);
+        for (int u = 0; u < n; u++) {
+            for (int v : graph.getNeighbors(u)) {
+                degree[u]++;
+                if (graph.isDirected()) {
+                    degree[v]++;
+                }
+            }
+        }
+
+        vector <int> order (n);
+        for (int v = 0; v < n; v++) {
+            order[v] = v;
+        }
+        std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return degree[a] > degree[b]; });
+        return orderToPermutation(order);
+    }
+
+    // Gorder-style greedy ordering: repeatedly place the unplaced vertex with the
+    // highest locality score against the last `window` placed vertices, where the
+    // score counts direct edges plus shared in-neighbors (siblings). Hubs with more
+    // than sqrt(n) out-edges are skipped for sibling updates to bound the cost.
+    static std::vector<int> gorder(const Graph &graph, int window = 5)
+    {
+        int n = graph.getNumVertices();
+        CSRData out, in;
+        {
+            EdgeList edges;
+            edges.numVertices = n;
+            for (int u = 0; u < n; u++) {
+                for (int v : graph.getNeighbors(u)) {
+                    edges.sources.push_back(u);
+                    edges.targets.push_back(v);
+                }
+            }
+            out = buildCSR(edges, false);
+            edges.sources.swap(edges.targets);
+            in = buildCSR(edges, false);
+        }
+
+        const int64_t hubLimit = std::max<int64_t>(16, (int64_t)std::sqrt((double)n));
+        vector <int> score (n, 0);
+        vector <bool> placed (n, false);
+        std::priority_queue<std::pair<int, int>> heap; // (score, vertex), stale entries skipped
+
+        auto update = [&](int v, int delta) {
+            auto bump = [&](int u) {
+                if (!placed[u]) {
+                    score[u] += delta;
+                    if (score[u] > 0) {
+                        heap.push({score[u], u});
+                    }
+                }
+            };
+            for (int64_t i = out.offsets[v]; i < out.offsets[v + 1]; i++) {
+                bump(out.targets[i]);
+            }
+            for (int64_t i = in.offsets[v]; i < in.offsets[v + 1]; i++) {
+                int w = in.targets[i];
+                bump(w);
+                if (out.degree(w) <= hubLimit) {
+                    for (int64_t j = out.offsets[w]; j < out.offsets[w + 1]; j++) {
+                        if (out.targets[j] != v) {
+                            bump(out.targets[j]);
+                        }
+                    }
+                }
+            }
+        };
+
+        // Fallback seeds when no unplaced vertex has a positive score: highest in-degree first
+        vector <int> seeds (n);
+        for (int v = 0; v < n; v++) {
+            seeds[v] = v;
+        }
+        std::stable_sort(seeds.begin(), seeds.end(), [&](int a, int b) { return in.degree(a) > in.degree(b); });
+        size_t nextSeed = 0;
+
+        vector <int> order;
+        order.reserve(n);
+        while ((int)order.size() < n) {
+            int v = -1;
+            while (!heap.empty()) {
+                auto [s, u] = heap.top();
+                heap.pop();
+                if (!placed[u] && s == score[u]) {
+                    v = u;
+                    break;
+                }
+            }
+            if (v == -1) {
+                while (placed[seeds[nextSeed]]) {
+                    nextSeed++;
+                }
+                v = seeds[nextSeed];
+            }
+
+            placed[v] = true;
+            order.push_back(v);
+            update(v, +1);
+            if ((int)order.size() > window) {
+                update(order[order.size() - 1 - window], -1);
+            }
+        }
+
+        return orderToPermutation(order);
+    }
+
+    // Inverse permutation: inverse(newId)[newId] = oldId
+    static std::vector<int> inverse(const std::vector<int> &permutation)
+    {
+        vector <int> result (permutation.size());
+        for (size_t i = 0; i < permutation.size(); i++) {
+            result[permutation[i]] = i;
+        }
+        return result;
+    }
+
+    // Copy of the graph with vertex v renamed to newId[v]; rows are sorted by new id
+    static AdjacencyListGraph relabel(const Graph &graph, const std::vector<int> &newId)
+    {
+        EdgeList edges;
+        edges.numVertices = graph.getNumVertices();
+        for (int u = 0; u < graph.getNumVertices(); u++) {
+            for (int v : graph.getNeighbors(u)) {
+                edges.sources.push_back(newId[u]);
+                edges.targets.push_back(newId[v]);
+            }
+        }
+
+        return AdjacencyListGraph::fromCSR(buildCSR(edges, false), graph.isDirected());
+    }
+};
+
+//-------------------- INCREMENTAL CONNECTIVITY --------------------
+// Connected components of an undirected graph under edge insertions:
+// union-find with union by size and path halving, so addEdge and connected()
+// run in near-constant (inverse Ackermann) amortized time.
+class IncrementalConnectivity
+{
+private:
+    std::vector<int> parent;
+    std::vector<int> componentSize;
+    int numComponents;
+
+public:
+    IncrementalConnectivity(int vertices) : parent(vertices), componentSize(vertices, 1), numComponents(vertices)
+    {
+        for (int v = 0; v < vertices; v++) {
+            parent[v] = v;
+        }
+    }
+
+    // Start from the components of an existing graph
+    explicit IncrementalConnectivity(const Graph &graph) : IncrementalConnectivity(graph.getNumVertices())
+    {
+        for (int u = 0; u < graph.getNumVertices(); u++) {
+            for (int v : graph.getNeighbors(u)) {
+                addEdge(u, v);
+            }
+        }
+    }
+
+    // Representative of the component containing `vertex`
+    int find(int vertex)
+    {
+        while (parent[vertex] != vertex) {
+            parent[vertex] = parent[parent[vertex]];
+            vertex = parent[vertex];
+        }
+        return vertex;
+    }
+
+    int addVertex()
+    {
+        parent.push_back(parent.size());
+        componentSize.push_back(1);
+        numComponents++;
+        return parent.size() - 1;
+    }
+
+    // Insert an undirected edge; returns true if it merged two components
+    bool addEdge(int source, int destination)
+    {
+        int a = find(source), b = find(destination);
+        if (a == b) {
+            return false;
+        }
+        if (componentSize[a] < componentSize[b]) {
+            std::swap(a, b);
+        }
+        parent[b] = a;
+        componentSize[a] += componentSize[b];
+        numComponents--;
+        return true;
+    }
+
+    bool connected(int u, int v)
+    {
+        return find(u) == find(v);
+    }
+
+    int getComponentCount() const
+    {
+        return numComponents;
+    }
+};
+
+// Strongly connected components of a directed graph under edge insertions.
+// Components are union-find sets; the condensation DAG keeps a topological
+// order maintained with the Pearce-Kelly algorithm. An edge that agrees with
+// the order costs O(1). Otherwise only the affected region between the two
+// endpoints' positions is searched: if the edge closes a cycle, every
+// component on it is merged, else that region is reordered.
+class IncrementalSCC
+{
+private:
+    std::vector<int> parent;
+    std::vector<int> componentSize;
+    std::vector<int> position;                // Topological position of each representative
+    std::vector<std::vector<int>> outEdges;   // Per representative: original endpoints, resolved with find()
+    std::vector<std::vector<int>> inEdges;
+    std::vector<int> forwardMark, backwardMark;
+    int stamp = 0;
+    int numComponents;
+
+    // Collect representatives reachable from `start` (along `edges`) whose position
+    // lies inside the window; stops descending at `stopAt`. Returns true if it was reached.
+    bool search(int start, std::vector<std::vector<int>> &edges, std::vector<int> &mark,
+                int lowPosition, int highPosition, int stopAt, std::vector<int> &found)
+    {
+        bool reached = false;
+        vector <int> store (1, start);
+        mark[start] = stamp;
+
+        while (!store.empty()) {
+            int current = store.back();
+            store.pop_back();
+            found.push_back(current);
+            if (current == stopAt) {
+                reached = true;
+                continue;
+            }
+
+            // Edges that became internal after a merge are dropped for good while scanning
+            std::vector<int> &list = edges[current];
+            size_t kept = 0;
+            for (size_t i = 0; i < list.size(); i++) {
+                int next = find(list[i]);
+                if (next == current) {
+                    continue;
+                }
+                list[kept++] = list[i];
+                if (mark[next] != stamp && position[next] >= lowPosition && position[next] <= highPosition) {
+                    mark[next] = stamp;
+                    store.push_back(next);
+                }
+            }
+            list.resize(kept);
+        }
+
+        return reached;
+    }
+
+    int unite(int a, int b)
+    {
+        if (componentSize[a] < componentSize[b]) {
+            std::swap(a, b);
+        }
+        parent[b] = a;
+        componentSize[a] += componentSize[b];
+        numComponents--;
+
+        // Small-to-large: move the smaller edge lists into the surviving representative
+        auto absorb = [](std::vector<int> &into, std::vector<int> &from) {
+            if (into.size() < from.size()) {
+                into.swap(from);
+            }
+            into.insert(into.end(), from.begin(), from.end());
+            std::vector<int>().swap(from);
+        };
+        absorb(outEdges[a], outEdges[b]);
+        absorb(inEdges[a], inEdges[b]);
+        return a;
+    }
+
+public:
+    IncrementalSCC(int vertices)
+        : parent(vertices), componentSize(vertices, 1), position(vertices), outEdges(vertices),
+          inEdges(vertices), forwardMark(vertices, -1), backwardMark(vertices, -1), numComponents(vertices)
+    {
+        for (int v = 0; v < vertices; v++) {
+            parent[v] = v;
+            position[v] = v;
+        }
+    }
+
+    // Start from the components of an existing directed graph
+    explicit IncrementalSCC(const Graph &graph) : IncrementalSCC(graph.getNumVertices())
+    {
+        for (int u = 0; u < graph.getNumVertices(); u++) {
+            for (int v : graph.getNeighbors(u)) {
+                addEdge(u, v);
+            }
+        }
+    }
+
+    // Representative of the strongly connected component containing `vertex`
+    int find(int vertex)
+    {
+        while (parent[vertex] != vertex) {
+            parent[vertex] = parent[parent[vertex]];
+            vertex = parent[vertex];
+        }
+        return vertex;
+    }
+
+    bool stronglyConnected(int u, int v)
+    {
+        return find(u) == find(v);
+    }
+
+    int getComponentCount() const
+    {
+        return numComponents;
+    }
+
+    // Insert the directed edge source -> destination; returns true if it merged components
+    bool addEdge(int source, int destination)
+    {
+        int from = find(source), to = find(destination);
+        if (from == to) {
+            return false;
+        }
+
+        outEdges[from].push_back(destination);
+        inEdges[to].push_back(source);
+        if (position[from] < position[to]) {
+            return false;
+        }
+
+        // The edge points backwards in the order: search the affected window
+        int low = position[to], high = position[from];
+        stamp++;
+        vector <int> forward, backward;
+        bool cycle = search(to, outEdges, forwardMark, low, high, from, forward);
+        search(from, inEdges, backwardMark, low, high, -1, backward);
+
+        // Positions available for reassignment, in increasing order
+        vector <int> slots;
+        for (int c : backward) {
+            slots.push_back(position[c]);
+        }
+        for (int c : forward) {
+            if (backwardMark[c] != stamp) {
+                slots.push_back(position[c]);
+            }
+        }
+        std::sort(slots.begin(), slots.end());
+
+        auto byPosition = [&](int a, int b) { return position[a] < position[b]; };
+        std::sort(backward.begin(), backward.end(), byPosition);
+        std::sort(forward.begin(), forward.end(), byPosition);
+
+        // Predecessors of `from` take the lowest slots and successors of `to` the
+        // highest, so neither moves past a vertex outside the window. When the edge
+        // closes a cycle, components in both sets merge into one SCC placed in between.
+        vector <int> head, tail;
+        int merged = -1;
+        for (int c : backward) {
+            if (cycle && forwardMark[c] == stamp) {
+                merged = merged == -1 ? c : unite(merged, c);
+            } else {
+                head.push_back(c);
+            }
+        }
+        for (int c : forward) {
+            if (backwardMark[c] != stamp) {
+                tail.push_back(c);
+            }
+        }
+
+        for (size_t i = 0; i < head.size(); i++) {
+            position[head[i]] = slots[i];
+        }
+        if (merged != -1) {
+            position[merged] = slots[head.size()];
+        }
+        for (size_t i = 0; i < tail.size(); i++) {
+            position[tail[i]] = slots[slots.size() - tail.size() + i];
+        }
+
+        return cycle;
+    }
+};
+
+//-------------------- ITERATIVE VERTEX-CENTRIC ENGINE --------------------
+// Synchronous, pull-based iterations over CSR: every round, each vertex reads its
+// in-neighbors' values from the current buffer and writes its own new value to
+// the next one, so vertices are updated in parallel without locks or atomics.
+// Buffers are swapped after each round, which is timed and recorded.
+class IterativeEngine
+{
+public:
+    struct IterationStats
+    {
+        int iteration;
+        double delta;        // L1 change for ranks, number of changed labels for labels
+        double milliseconds;
+    };
+
+private:
+    int numVertices;
+    CSRData ownedIncoming;    // Transposed edges; empty when the input is undirected
+    CSRView incoming;
+    std::vector<int> outDegree;
+    unsigned numThreads;
+
+    // Per-worker partial sums, padded so workers do not share cache lines
+    struct alignas(64) Partial
+    {
+        double value = 0.0;
+    };
+
+    double sumOver(const std::vector<Partial> &partials) const
+    {
+        double total = 0.0;
+        for (const Partial &partial : partials) {
+            total += partial.value;
+        }
+        return total;
+    }
+
+    void initialize(const CSRView &outgoing, bool isDirected)
+    {
+        numVertices = outgoing.numVertices;
+        outDegree.resize(numVertices);
+        for (int v = 0; v < numVertices; v++) {
+            outDegree[v] = (int)outgoing.degree(v);
+        }
+
+        if (!isDirected) {
+            incoming = outgoing;
+            return;
+        }
+
+        EdgeList reversed;
+        reversed.numVertices = numVertices;
+        reversed.sources.reserve(outgoing.numEdges);
+        reversed.targets.reserve(outgoing.numEdges);
+        for (int u = 0; u < numVertices; u++) {
+            for (int64_t e = outgoing.offsets[u]; e < outgoing.offsets[u + 1]; e++) {
+                reversed.sources.push_back(outgoing.targets[e]);
+                reversed.targets.push_back(u);
+            }
+        }
+        ownedIncoming = buildCSR(reversed, false, false);
+        incoming = viewOf(ownedIncoming);
+    }
+
+    // Shared PageRank loop; `teleport` is the restart distribution (sums to 1)
+    int rankIterations(const std::vector<float> &teleport, std::vector<float> &rank, double damping,
+                       double tolerance, int maxIterations, std::vector<IterationStats> *stats)
+    {
+        int n = numVertices;
+        rank = teleport;
+        std::vector<float> next (n), contribution (n);
+        std::vector<Partial> dangling (numThreads), change (numThreads);
+
+        int iteration = 0;
+        while (iteration < maxIterations) {
+            auto start = chrono::steady_clock::now();
+
+            // Scatter-free pull: precompute rank / out-degree once per vertex, and
+            // collect the mass of vertices without out-edges to redistribute it
+            for (Partial &partial : dangling) {
+                partial.value = 0.0;
+            }
+            parallelFor(n, numThreads, 8192, [&](size_t begin, size_t end, unsigned t) {
+                double lost = 0.0;
+                for (size_t v = begin; v < end; v++) {
+                    if (outDegree[v] > 0) {
+                        contribution[v] = rank[v] / outDegree[v];
+                    } else {
+                        contribution[v] = 0.0f;
+                        lost += rank[v];
+                    }
+                }
+                dangling[t].value += lost;
+            });
+            double danglingMass = sumOver(dangling);
+
+            for (Partial &partial : change) {
+                partial.value = 0.0;
+            }
+            parallelFor(n, numThreads, 1024, [&](size_t begin, size_t end, unsigned t) {
+                double delta = 0.0;
+                for (size_t v = begin; v < end; v++) {
+                    double sum = 0.0;
+                    for (int64_t e = incoming.offsets[v]; e < incoming.offsets[v + 1]; e++) {
+                        sum += contribution[incoming.targets[e]];
+                    }
+                    double value = (1.0 - damping) * teleport[v] + damping * (sum + danglingMass * teleport[v]);
+                    next[v] = (float)value;
+                    delta += std::fabs(value - rank[v]);
+                }
+                change[t].value += delta;
+            });
+
+            rank.swap(next);
+            iteration++;
+            double delta = sumOver(change);
+            if (stats) {
+                stats->push_back({iteration, delta,
+                                  chrono::duration<double, milli>(chrono::steady_clock::now() - start).count()});
+            }
+            if (delta < tolerance) {
+                break;
+            }
+        }
+        return iteration;
+    }
+
+public:
+    IterativeEngine(const Graph &graph, unsigned numThreads = 0) : numThreads(resolveThreads(numThreads))
+    {
+        EdgeList edges;
+        edges.numVertices = graph.getNumVertices();
+        for (int u = 0; u < graph.getNumVertices(); u++) {
+            for (int v : graph.getNeighbors(u)) {
+                edges.sources.push_back(u);
+                edges.targets.push_back(v);
+            }
+        }
+
+        // Undirected rows are their own transpose, so keep them as `incoming`
+        CSRData outgoing = buildCSR(edges, false, false);
+        if (graph.isDirected()) {
+            initialize(viewOf(outgoing), true);
+        } else {
+            ownedIncoming = std::move(outgoing);
+            initialize(viewOf(ownedIncoming), false);
+        }
+    }
+
+    // Work directly on CSR arrays (e.g. CSRGraph::view()); an undirected view is
+    // used as its own transpose and must outlive the engine
+    IterativeEngine(const CSRView &outgoing, bool isDirected, unsigned numThreads = 0)
+        : numThreads(resolveThreads(numThreads))
+    {
+        initialize(outgoing, isDirected);
+    }
+
+    // `incoming` may point into ownedIncoming, so copies would dangle
+    IterativeEngine(const IterativeEngine &) = delete;
+    IterativeEngine &operator=(const IterativeEngine &) = delete;
+
+    // PageRank with uniform teleport; mass of dangling vertices is spread
+    // uniformly too, so ranks always sum to 1. Stops once the L1 change of a
+    // round drops below `tolerance`. Returns the number of rounds run.
+    int pageRank(std::vector<float> &rank, double damping = 0.85, double tolerance = 1e-6, int maxIterations = 100,
+                 std::vector<IterationStats> *stats = nullptr)
+    {
+        std::vector<float> teleport (numVertices, numVertices ? 1.0f / numVertices : 0.0f);
+        return rankIterations(teleport, rank, damping, tolerance, maxIterations, stats);
+    }
+
+    // Personalized PageRank: random surfers restart at one of `sources`
+    // (uniformly), so ranks measure proximity to that seed set. Out-of-range
+    // sources are ignored; with no valid source every rank is 0.
+    int personalizedPageRank(const std::vector<int> &sources, std::vector<float> &rank, double damping = 0.85,
+                             double tolerance = 1e-6, int maxIterations = 100,
+                             std::vector<IterationStats> *stats = nullptr)
+    {
+        std::vector<int> valid;
+        for (int source : sources) {
+            if (source >= 0 && source < numVertices) {
+                valid.push_back(source);
+            }
+        }
+        if (valid.empty()) {
+            rank.assign(numVertices, 0.0f);
+            return 0;
+        }
+
+        std::vector<float> teleport (numVertices, 0.0f);
+        for (int source : valid) {
+            teleport[source] += 1.0f / valid.size();
+        }
+        return rankIterations(teleport, rank, damping, tolerance, maxIterations, stats);
+    }
+
+    // Label propagation communities: every vertex starts with its own id and
+    // repeatedly adopts the most frequent label among its in-neighbors (ties go
+    // to the smallest label; a vertex keeps its label if it is among the most
+    // frequent). Stops when no label changes. Returns the number of rounds.
+    int labelPropagation(std::vector<int> &label, int maxIterations = 100, std::vector<IterationStats> *stats = nullptr)
+    {
+        int n = numVertices;
+        label.resize(n);
+        for (int v = 0; v < n; v++) {
+            label[v] = v;
+        }
+        std::vector<int> next (n);
+        std::vector<Partial> change (numThreads);
+        std::vector<std::vector<int>> scratch (numThreads);
+
+        int iteration = 0;
+        while (iteration < maxIterations) {
+            auto start = chrono::steady_clock::now();
+            for (Partial &partial : change) {
+                partial.value = 0.0;
+            }
+
+            parallelFor(n, numThreads, 1024, [&](size_t begin, size_t end, unsigned t) {
+                std::vector<int> &labels = scratch[t];
+                int changed = 0;
+                for (size_t v = begin; v < end; v++) {
+                    labels.clear();
+                    for (int64_t e = incoming.offsets[v]; e < incoming.offsets[v + 1]; e++) {
+                        labels.push_back(label[incoming.targets[e]]);
+                    }
+                    if (labels.empty()) {
+                        next[v] = label[v];
+                        continue;
+                    }
+                    std::sort(labels.begin(), labels.end());
+
+                    int best = labels[0], bestCount = 0, ownCount = 0;
+                    for (size_t i = 0; i < labels.size();) {
+                        size_t j = i;
+                        while (j < labels.size() && labels[j] == labels[i]) {
+                            j++;
+                        }
+                        int count = (int)(j - i);
+                        if (count > bestCount) {
+                            best = labels[i];
+                            bestCount = count;
+                        }
+                        if (labels[i] == label[v]) {
+                            ownCount = count;
+                        }
+                        i = j;
+                    }
+
+                    next[v] = ownCount == bestCount ? label[v] : best;
+                    changed += next[v] != label[v];
+                }
+                change[t].value += changed;
+            });
+
+            label.swap(next);
+            iteration++;
+            double changed = sumOver(change);
+            if (stats) {
+                stats->push_back({iteration, changed,
+                                  chrono::duration<double, milli>(chrono::steady_clock::now() - start).count()});
+            }
+            if (changed == 0) {
+                break;
+            }
+        }
+        return iteration;
     }
+};
 
+//-------------------- GRAPH PARTITIONING --------------------
+// Split a graph into shards that can live in separate processes (or machines).
+// A shard stores the out-edges of the vertices it owns; edge targets owned by
+// other shards become local "ghost" vertices, and the ghost table records where
+// each ghost lives so that messages can be addressed with the owner's local id.
+enum class PartitionStrategy
+{
+    Hash,   // Scattered ids: perfect balance, cuts almost every edge
+    Range,  // Contiguous id blocks with equal (degree + 1) weight: good when ids have locality
+    Fennel  // Streaming greedy: join the shard holding most neighbors, minus a size penalty
+};
 
-    // Topological sort (for directed acyclic graphs)
-    static std::vector<int> topologicalSort(const Graph &graph)
+struct GraphShard
+{
+    int shardId = 0;
+    int numOwned = 0;
+    std::vector<int> localToGlobal; // Owned vertices first, then ghosts
+    CSRData csr;                    // numOwned rows; targets are local ids
+
+    // Ghost table, indexed by (local id - numOwned)
+    std::vector<int> ghostOwner;       // Shard that owns the ghost
+    std::vector<int> ghostRemoteIndex; // Its local id inside that shard
+
+    int numGhosts() const
     {
-        // TODO: Implement topological sort using DFS
-        // 1. Run DFS on each unvisited vertex
-        // 2. After exploring all neighbors of a vertex, add it to the front of the result list
-        // 3. Return the result list (in reverse order of completion time)
-        vector <bool> visited (graph.getNumVertices(), false);
-        stack <int> s;
+        return (int)localToGlobal.size() - numOwned;
+    }
+};
 
-        for (int v = 0; v < graph.getNumVertices(); v++) {
-            if (!visited[v]) {
-                topoDFS(graph, v, visited, s);
+class GraphPartitioner
+{
+private:
+    static uint64_t mix(uint64_t x)
+    {
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdull;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ull;
+        return x ^ (x >> 33);
+    }
+
+    static std::vector<int> rangeOwners(const Graph &graph, int numShards)
+    {
+        int n = graph.getNumVertices();
+        int64_t totalWeight = 0;
+        for (int v = 0; v < n; v++) {
+            totalWeight += (int64_t)graph.getNeighbors(v).size() + 1;
+        }
+
+        vector <int> owner (n);
+        int64_t prefix = 0;
+        for (int v = 0; v < n; v++) {
+            owner[v] = (int)std::min<int64_t>(numShards - 1, prefix * numShards / std::max<int64_t>(1, totalWeight));
+            prefix += (int64_t)graph.getNeighbors(v).size() + 1;
+        }
+        return owner;
+    }
+
+    // Fennel (Tsourakakis et al.): vertices arrive in id order and go to the shard
+    // maximizing |N(v) in shard| - alpha * gamma * |shard|^(gamma - 1), subject to
+    // |shard| <= slack * n / k. alpha = m * k^(gamma - 1) / n^gamma balances the
+    // two terms so that neither cut nor balance dominates.
+    static std::vector<int> fennelOwners(const Graph &graph, int numShards, double gamma, double slack)
+    {
+        CSRData csr = symmetricCSR(graph);
+        int n = csr.numVertices;
+        double m = csr.numEdges() / 2.0;
+        double alpha = m * std::pow((double)numShards, gamma - 1.0) / std::pow(std::max(1, n), gamma);
+        double capacity = std::max(1.0, slack * n / numShards);
+
+        vector <int> owner (n, -1), shardSize (numShards, 0), neighborsIn (numShards, 0);
+        for (int v = 0; v < n; v++) {
+            for (int64_t e = csr.offsets[v]; e < csr.offsets[v + 1]; e++) {
+                if (csr.targets[e] != v && owner[csr.targets[e]] >= 0) {
+                    neighborsIn[owner[csr.targets[e]]]++;
+                }
+            }
+
+            int best = -1;
+            double bestScore = 0.0;
+            for (int shard = 0; shard < numShards; shard++) {
+                if (shardSize[shard] + 1 > capacity) {
+                    continue;
+                }
+                double score = neighborsIn[shard] - alpha * gamma * std::pow((double)shardSize[shard], gamma - 1.0);
+                if (best == -1 || score > bestScore) {
+                    best = shard;
+                    bestScore = score;
+                }
+            }
+            if (best == -1) {
+                best = (int)(std::min_element(shardSize.begin(), shardSize.end()) - shardSize.begin());
+            }
+            owner[v] = best;
+            shardSize[best]++;
+
+            // Reset the counters for the next vertex
+            for (int64_t e = csr.offsets[v]; e < csr.offsets[v + 1]; e++) {
+                if (csr.targets[e] != v && owner[csr.targets[e]] >= 0) {
+                    neighborsIn[owner[csr.targets[e]]]--;
+                }
             }
         }
+        return owner;
+    }
 
-        vector <int> topoOrder;
-        while (!s.empty()) {
-            topoOrder.push_back(s.top());
-            s.pop();
+public:
+    // Owner shard of every vertex
+    static std::vector<int> assign(const Graph &graph, int numShards, PartitionStrategy strategy,
+                                   double fennelGamma = 1.5, double fennelSlack = 1.1)
+    {
+        int n = graph.getNumVertices();
+        numShards = std::max(1, numShards);
+        switch (strategy) {
+        case PartitionStrategy::Range:
+            return rangeOwners(graph, numShards);
+        case PartitionStrategy::Fennel:
+            return fennelOwners(graph, numShards, fennelGamma, fennelSlack);
+        case PartitionStrategy::Hash:
+        default:
+            break;
         }
 
-        return topoOrder; // Placeholder
+        vector <int> owner (n);
+        for (int v = 0; v < n; v++) {
+            owner[v] = (int)(mix((uint64_t)v) % numShards);
+        }
+        return owner;
     }
-    // Helper function for first DFS pass in Kosaraju's algorithm
-    static void kosarajuFirstDFS(const Graph &graph, int vertex, std::vector<bool> &visited,
-                                 std::stack<int> &finishOrder)
+
+    // Edges whose endpoints live on different shards
+    static int64_t edgeCut(const Graph &graph, const std::vector<int> &owner)
     {
-        // TODO: Implement first DFS pass of Kosaraju's algorithm
-        // 1. Mark current vertex as visited
-        // 2. Recursively visit all unvisited neighbors
-        // 3. After processing all neighbors, push current vertex to finishOrder stack
-        // (This creates a stack with vertices ordered by decreasing finish time)
-        visited[vertex] = true;
+        int64_t cut = 0;
+        for (int u = 0; u < graph.getNumVertices(); u++) {
+            for (int v : graph.getNeighbors(u)) {
+                cut += owner[u] != owner[v];
+            }
+        }
+        return graph.isDirected() ? cut : cut / 2;
+    }
 
-        for (int neighbor : graph.getNeighbors(vertex)) {
-            if (!visited[neighbor]) {
-                kosarajuFirstDFS(graph, neighbor, visited, finishOrder);
+    // Build one shard per owner id in [0, numShards)
+    static std::vector<GraphShard> split(const Graph &graph, const std::vector<int> &owner, int numShards)
+    {
+        int n = graph.getNumVertices();
+        std::vector<GraphShard> shards (numShards);
+        vector <int> ownedIndex (n);
+        for (int v = 0; v < n; v++) {
+            GraphShard &shard = shards[owner[v]];
+            ownedIndex[v] = shard.numOwned++;
+            shard.localToGlobal.push_back(v);
+        }
+
+        vector <int> ghostIndex (n, -1); // Local id of a ghost in the shard being built
+        for (int s = 0; s < numShards; s++) {
+            GraphShard &shard = shards[s];
+            shard.shardId = s;
+            shard.csr.numVertices = shard.numOwned;
+            shard.csr.offsets.assign(shard.numOwned + 1, 0);
+
+            for (int local = 0; local < shard.numOwned; local++) {
+                for (int v : graph.getNeighbors(shard.localToGlobal[local])) {
+                    if (owner[v] == s) {
+                        shard.csr.targets.push_back(ownedIndex[v]);
+                        continue;
+                    }
+                    if (ghostIndex[v] == -1) {
+                        ghostIndex[v] = (int)shard.localToGlobal.size();
+                        shard.localToGlobal.push_back(v);
+                        shard.ghostOwner.push_back(owner[v]);
+                        shard.ghostRemoteIndex.push_back(ownedIndex[v]);
+                    }
+                    shard.csr.targets.push_back(ghostIndex[v]);
+                }
+                shard.csr.offsets[local + 1] = (int64_t)shard.csr.targets.size();
+            }
+
+            for (int ghost = shard.numOwned; ghost < (int)shard.localToGlobal.size(); ghost++) {
+                ghostIndex[shard.localToGlobal[ghost]] = -1;
             }
         }
+        return shards;
+    }
+};
+
+//-------------------- MULTI-PROCESS SHARDED BFS --------------------
+// Level-synchronous BFS where every shard runs in its own process (fork) and only
+// frontier messages cross shard boundaries: each level a shard expands its local
+// frontier, sends the ghost vertices it reached to their owners through pipes,
+// then absorbs the vertices other shards sent it. Every message carries an
+// "active" flag, and all shards stop after a level where nobody was active.
+// Without fork (non-POSIX builds) the same shards are stepped in one process.
+class ShardedBFS
+{
+private:
+    struct ShardState
+    {
+        const GraphShard *shard;
+        std::vector<int> distance; // Per owned vertex
+        std::vector<int> frontier;
+        std::vector<int> next;
+        std::vector<std::vector<int>> outbox; // Owner-local ids per destination shard
+        std::vector<char> sentGhost;          // Ghost already sent during this search
+    };
 
-        finishOrder.push(vertex);
+    static void initState(ShardState &state, const GraphShard &shard, int numShards)
+    {
+        state.shard = &shard;
+        state.distance.assign(shard.numOwned, -1);
+        state.frontier.clear();
+        state.next.clear();
+        state.outbox.assign(numShards, {});
+        state.sentGhost.assign(shard.numGhosts(), 0);
     }
 
-    // Helper function for second DFS pass in Kosaraju's algorithm
-    static void kosarajuSecondDFS(const Graph &graph, int vertex, std::vector<bool> &visited,
-                                  std::vector<int> &component)
+    // Expand the frontier at `level`; returns true if anything was discovered or queued
+    static bool expand(ShardState &state, int level)
     {
-        // TODO: Implement second DFS pass of Kosaraju's algorithm
-        // 1. Mark current vertex as visited
-        // 2. Add current vertex to the current component
-        // 3. Recursively visit all unvisited neighbors
-        // (This identifies vertices in the current strongly connected component)
-        visited[vertex] = true;
-        component.push_back(vertex);
+        const GraphShard &shard = *state.shard;
+        state.next.clear();
+        for (std::vector<int> &box : state.outbox) {
+            box.clear();
+        }
 
-        for (int neighbor : graph.getNeighbors(vertex)) {
-            if (!visited[neighbor]) {
-                kosarajuSecondDFS(graph, neighbor, visited, component);
+        for (int u : state.frontier) {
+            for (int64_t e = shard.csr.offsets[u]; e < shard.csr.offsets[u + 1]; e++) {
+                int v = shard.csr.targets[e];
+                if (v < shard.numOwned) {
+                    if (state.distance[v] == -1) {
+                        state.distance[v] = level + 1;
+                        state.next.push_back(v);
+                    }
+                } else if (!state.sentGhost[v - shard.numOwned]) {
+                    // A ghost is reached at its earliest level the first time, so one send is enough
+                    state.sentGhost[v - shard.numOwned] = 1;
+                    int ghost = v - shard.numOwned;
+                    state.outbox[shard.ghostOwner[ghost]].push_back(shard.ghostRemoteIndex[ghost]);
+                }
+            }
+        }
+
+        bool active = !state.next.empty();
+        for (const std::vector<int> &box : state.outbox) {
+            active = active || !box.empty();
+        }
+        return active;
+    }
+
+    static void absorb(ShardState &state, const int *vertices, size_t count, int level)
+    {
+        for (size_t i = 0; i < count; i++) {
+            if (state.distance[vertices[i]] == -1) {
+                state.distance[vertices[i]] = level + 1;
+                state.next.push_back(vertices[i]);
+            }
+        }
+    }
+
+    static void runInProcess(const std::vector<GraphShard> &shards, const std::vector<int> &owner,
+                             const std::vector<int> &ownedIndex, int source, std::vector<int> &distance)
+    {
+        int k = (int)shards.size();
+        std::vector<ShardState> states (k);
+        for (int s = 0; s < k; s++) {
+            initState(states[s], shards[s], k);
+        }
+        states[owner[source]].distance[ownedIndex[source]] = 0;
+        states[owner[source]].frontier.push_back(ownedIndex[source]);
+
+        for (int level = 0;; level++) {
+            bool active = false;
+            for (ShardState &state : states) {
+                active = expand(state, level) || active;
+            }
+            if (!active) {
+                break;
+            }
+            for (ShardState &sender : states) {
+                for (int s = 0; s < k; s++) {
+                    absorb(states[s], sender.outbox[s].data(), sender.outbox[s].size(), level);
+                }
+            }
+            for (ShardState &state : states) {
+                state.frontier.swap(state.next);
+            }
+        }
+
+        for (int s = 0; s < k; s++) {
+            for (int local = 0; local < shards[s].numOwned; local++) {
+                distance[shards[s].localToGlobal[local]] = states[s].distance[local];
+            }
+        }
+    }
+
+#if defined(__unix__) || defined(__APPLE__)
+    // Send every outbox and receive one message from every peer, multiplexing the
+    // non-blocking pipes with poll() so that full pipes never deadlock two shards
+    // writing to each other. Message: int64 count, int64 active flag, count ids.
+    // Returns false if a peer went away.
+    static bool exchange(int self, const std::vector<int> &writeFd, const std::vector<int> &readFd,
+                         const std::vector<std::vector<int>> &outbox, bool active,
+                         std::vector<std::vector<int>> &inbox, bool &anyActive)
+    {
+        int k = (int)writeFd.size();
+        std::vector<std::string> sendBuffer (k);
+        std::vector<size_t> sent (k, 0), received (k, 0);
+        std::vector<std::string> receiveBuffer (k);
+        std::vector<char> headerDone (k, 0), receiveDone (k, 0), sendDone (k, 0);
+        int pending = 0;
+
+        for (int peer = 0; peer < k; peer++) {
+            if (peer == self) {
+                sendDone[peer] = receiveDone[peer] = 1;
+                continue;
+            }
+            int64_t header[2] = {(int64_t)outbox[peer].size(), active ? 1 : 0};
+            sendBuffer[peer].assign((const char *)header, sizeof(header));
+            sendBuffer[peer].append((const char *)outbox[peer].data(), outbox[peer].size() * sizeof(int));
+            receiveBuffer[peer].resize(2 * sizeof(int64_t));
+            inbox[peer].clear();
+            pending += 2;
+        }
+
+        while (pending > 0) {
+            std::vector<pollfd> fds;
+            std::vector<int> peerOf;
+            for (int peer = 0; peer < k; peer++) {
+                if (!sendDone[peer]) {
+                    fds.push_back({writeFd[peer], POLLOUT, 0});
+                    peerOf.push_back(peer);
+                }
+                if (!receiveDone[peer]) {
+                    fds.push_back({readFd[peer], POLLIN, 0});
+                    peerOf.push_back(peer);
+                }
+            }
+            if (poll(fds.data(), fds.size(), -1) < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+
+            for (size_t i = 0; i < fds.size(); i++) {
+                int peer = peerOf[i];
+                if (fds[i].events == POLLOUT && (fds[i].revents & (POLLOUT | POLLERR | POLLHUP))) {
+                    ssize_t written = write(writeFd[peer], sendBuffer[peer].data() + sent[peer],
+                                            sendBuffer[peer].size() - sent[peer]);
+                    if (written < 0 && errno != EAGAIN && errno != EINTR) {
+                        return false;
+                    }
+                    sent[peer] += written > 0 ? written : 0;
+                    if (sent[peer] == sendBuffer[peer].size()) {
+                        sendDone[peer] = 1;
+                        pending--;
+                    }
+                } else if (fds[i].events == POLLIN && (fds[i].revents & (POLLIN | POLLERR | POLLHUP))) {
+                    std::string &buffer = receiveBuffer[peer];
+                    ssize_t got = read(readFd[peer], &buffer[received[peer]], buffer.size() - received[peer]);
+                    if (got == 0 || (got < 0 && errno != EAGAIN && errno != EINTR)) {
+                        return false;
+                    }
+                    received[peer] += got > 0 ? got : 0;
+                    if (received[peer] < buffer.size()) {
+                        continue;
+                    }
+
+                    int64_t header[2];
+                    std::memcpy(header, buffer.data(), sizeof(header));
+                    if (!headerDone[peer]) {
+                        headerDone[peer] = 1;
+                        anyActive = anyActive || header[1];
+                        buffer.resize(sizeof(header) + header[0] * sizeof(int));
+                    }
+                    if (received[peer] == buffer.size()) {
+                        inbox[peer].assign((const int *)(buffer.data() + sizeof(header)),
+                                           (const int *)(buffer.data() + buffer.size()));
+                        receiveDone[peer] = 1;
+                        pending--;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    // Body of one shard process: writes its owned distances into the shared result
+    static bool runShard(const GraphShard &shard, int numShards, int sourceShard, int sourceIndex,
+                         const std::vector<int> &writeFd, const std::vector<int> &readFd, int *result)
+    {
+        ShardState state;
+        initState(state, shard, numShards);
+        if (shard.shardId == sourceShard) {
+            state.distance[sourceIndex] = 0;
+            state.frontier.push_back(sourceIndex);
+        }
+
+        std::vector<std::vector<int>> inbox (numShards);
+        for (int level = 0;; level++) {
+            bool active = expand(state, level);
+            bool anyActive = active;
+            if (!exchange(shard.shardId, writeFd, readFd, state.outbox, active, inbox, anyActive)) {
+                return false;
+            }
+            if (!anyActive) {
+                break;
+            }
+            for (const std::vector<int> &message : inbox) {
+                absorb(state, message.data(), message.size(), level);
+            }
+            state.frontier.swap(state.next);
+        }
+
+        for (int local = 0; local < shard.numOwned; local++) {
+            result[shard.localToGlobal[local]] = state.distance[local];
+        }
+        return true;
+    }
+
+    static void runForked(const std::vector<GraphShard> &shards, int sourceShard, int sourceIndex, int numVertices,
+                          std::vector<int> &distance)
+    {
+        int k = (int)shards.size();
+        size_t bytes = std::max<size_t>(1, (size_t)numVertices * sizeof(int));
+        void *shared = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (shared == MAP_FAILED) {
+            throw std::runtime_error("Cannot map shared BFS result");
+        }
+        int *result = (int *)shared;
+
+        // pipeFds[from * k + to] carries messages from shard `from` to shard `to`
+        std::vector<int> pipeFds (2 * k * k, -1);
+        auto closeAll = [&]() {
+            for (int fd : pipeFds) {
+                if (fd >= 0) {
+                    close(fd);
+                }
+            }
+        };
+        for (int from = 0; from < k; from++) {
+            for (int to = 0; to < k; to++) {
+                if (from != to && pipe(&pipeFds[2 * (from * k + to)]) != 0) {
+                    closeAll();
+                    munmap(shared, bytes);
+                    throw std::runtime_error("Cannot create pipe for sharded BFS");
+                }
+            }
+        }
+
+        std::vector<pid_t> children;
+        for (int s = 0; s < k; s++) {
+            pid_t pid = fork();
+            if (pid == 0) {
+                // A dead peer must surface as EPIPE on write, not kill the shard, and
+                // nothing may unwind out of the child into the parent's frames
+                signal(SIGPIPE, SIG_IGN);
+                bool ok = false;
+                try {
+                    std::vector<int> writeFd (k, -1), readFd (k, -1);
+                    for (int peer = 0; peer < k; peer++) {
+                        if (peer == s) {
+                            continue;
+                        }
+                        writeFd[peer] = pipeFds[2 * (s * k + peer) + 1];
+                        readFd[peer] = pipeFds[2 * (peer * k + s)];
+                        fcntl(writeFd[peer], F_SETFL, O_NONBLOCK);
+                        fcntl(readFd[peer], F_SETFL, O_NONBLOCK);
+                    }
+                    // Close the ends this shard does not use, so a dead peer shows up as EOF
+                    for (int i = 0; i < (int)pipeFds.size(); i++) {
+                        if (pipeFds[i] >= 0 &&
+                            std::find(writeFd.begin(), writeFd.end(), pipeFds[i]) == writeFd.end() &&
+                            std::find(readFd.begin(), readFd.end(), pipeFds[i]) == readFd.end()) {
+                            close(pipeFds[i]);
+                        }
+                    }
+                    ok = runShard(shards[s], k, sourceShard, sourceIndex, writeFd, readFd, result);
+                } catch (...) {
+                    ok = false;
+                }
+                _exit(ok ? 0 : 1);
+            }
+            if (pid < 0) {
+                break;
+            }
+            children.push_back(pid);
+        }
+
+        closeAll();
+        bool ok = (int)children.size() == k;
+        for (pid_t child : children) {
+            int status = 0;
+            if (!ok) {
+                kill(child, SIGKILL);
+            }
+            waitpid(child, &status, 0);
+            ok = ok && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+        }
+
+        if (ok) {
+            distance.assign(result, result + numVertices);
+        }
+        munmap(shared, bytes);
+        if (!ok) {
+            throw std::runtime_error("Sharded BFS worker process failed");
+        }
+    }
+#endif
+
+public:
+    // Hop distance from `source` to every vertex (-1 if unreachable), computed on
+    // the shards of one graph. With useProcesses each shard runs in a forked
+    // process (POSIX only; elsewhere the shards are stepped in-process).
+    static void run(const std::vector<GraphShard> &shards, int source, std::vector<int> &distance,
+                    bool useProcesses = true)
+    {
+        int n = 0, sourceShard = -1, sourceIndex = -1;
+        for (const GraphShard &shard : shards) {
+            n += shard.numOwned;
+        }
+        distance.assign(n, -1);
+
+        std::vector<int> owner (n), ownedIndex (n);
+        for (const GraphShard &shard : shards) {
+            for (int local = 0; local < shard.numOwned; local++) {
+                owner[shard.localToGlobal[local]] = shard.shardId;
+                ownedIndex[shard.localToGlobal[local]] = local;
+            }
+        }
+        if (source < 0 || source >= n) {
+            return;
+        }
+        sourceShard = owner[source];
+        sourceIndex = ownedIndex[source];
+
+#if defined(__unix__) || defined(__APPLE__)
+        if (useProcesses && shards.size() > 1) {
+            runForked(shards, sourceShard, sourceIndex, n, distance);
+            return;
+        }
+#endif
+        runInProcess(shards, owner, ownedIndex, source, distance);
+    }
+};
+
+//-------------------- SEMI-EXTERNAL ALGORITHMS --------------------
+// BFS and connected components over binary edge files that do not fit in memory.
+// Only per-vertex arrays live in RAM (record offsets, distances, union-find
+// parents); the edges themselves are streamed from disk in large blocks.
+// BFS needs the file sorted by source (see sortEdgeFile); connected components
+// read it once in any order.
+class ExternalMemoryGraph
+{
+private:
+    std::string path;
+    size_t blockBytes;
+    int numVertices = 0;
+    int64_t numEdges = 0;
+    bool sorted = true;
+    std::vector<int64_t> offsets; // offsets[v]: first record with source v (sorted files)
+    int64_t bytesRead = 0;
+
+    static int findRoot(std::vector<int> &parent, int v)
+    {
+        while (parent[v] != v) {
+            parent[v] = parent[parent[v]]; // Path halving
+            v = parent[v];
+        }
+        return v;
+    }
+
+public:
+    // One sequential pass indexes the file: vertex count, per-source record
+    // offsets and whether the records are sorted by source. `minVertices` keeps
+    // isolated vertices above the largest id in the file.
+    explicit ExternalMemoryGraph(const std::string &path, size_t blockBytes = size_t(64) << 20, int minVertices = 0)
+        : path(path), blockBytes(blockBytes), numVertices(std::max(0, minVertices))
+    {
+        EdgeFileReader reader(path, blockBytes);
+        numEdges = reader.size();
+
+        vector <int64_t> degree (numVertices, 0);
+        int previous = 0;
+        for (size_t count = reader.readBlock(); count > 0; count = reader.readBlock()) {
+            for (size_t i = 0; i < count; i++) {
+                const EdgeRecord &record = reader.data()[i];
+                if (record.source < 0 || record.target < 0) {
+                    throw std::runtime_error("Negative vertex id in binary edge file: " + path);
+                }
+                int high = std::max(record.source, record.target);
+                if (high >= (int)degree.size()) {
+                    degree.resize(std::max<size_t>(high + 1, degree.size() * 2), 0);
+                }
+                numVertices = std::max(numVertices, high + 1);
+                degree[record.source]++;
+                sorted = sorted && record.source >= previous;
+                previous = record.source;
+            }
+        }
+        bytesRead = reader.totalBytesRead();
+
+        offsets.assign(numVertices + 1, 0);
+        for (int v = 0; v < numVertices; v++) {
+            offsets[v + 1] = offsets[v] + degree[v];
+        }
+    }
+
+    int getNumVertices() const
+    {
+        return numVertices;
+    }
+
+    int64_t getNumEdges() const
+    {
+        return numEdges;
+    }
+
+    bool isSorted() const
+    {
+        return sorted;
+    }
+
+    // Bytes read from disk by the last call (or by indexing, before any call)
+    int64_t lastBytesRead() const
+    {
+        return bytesRead;
+    }
+
+    // Hop distances from `source` along the file's edges (-1 if unreachable).
+    // Level by level, only the record ranges of frontier vertices are read, in
+    // file order; ranges separated by small gaps are read as one run, since
+    // reading through a gap is cheaper than a seek. Returns the number of levels.
+    int bfs(int source, std::vector<int> &distance)
+    {
+        if (!sorted) {
+            throw std::logic_error("External BFS needs an edge file sorted by source; run sortEdgeFile first");
+        }
+
+        distance.assign(numVertices, -1);
+        bytesRead = 0;
+        if (source < 0 || source >= numVertices) {
+            return 0;
+        }
+
+        EdgeFileReader reader(path, blockBytes);
+        const int64_t mergeGap = std::max<int64_t>(1, (int64_t)(blockBytes / sizeof(EdgeRecord) / 8));
+        vector <int> frontier (1, source), next;
+        distance[source] = 0;
+
+        int level = 0;
+        while (!frontier.empty()) {
+            std::sort(frontier.begin(), frontier.end());
+            next.clear();
+
+            auto relax = [&](const EdgeRecord *records, size_t count) {
+                for (size_t i = 0; i < count; i++) {
+                    if (distance[records[i].source] == level && distance[records[i].target] == -1) {
+                        distance[records[i].target] = level + 1;
+                        next.push_back(records[i].target);
+                    }
+                }
+            };
+
+            size_t i = 0;
+            while (i < frontier.size()) {
+                int64_t begin = offsets[frontier[i]], end = offsets[frontier[i] + 1];
+                for (i++; i < frontier.size() && offsets[frontier[i]] - end <= mergeGap; i++) {
+                    end = offsets[frontier[i] + 1];
+                }
+                if (begin < end) {
+                    reader.forEachBlock(begin, end, relax);
+                }
+            }
+
+            frontier.swap(next);
+            level++;
+        }
+
+        bytesRead = reader.totalBytesRead();
+        return level;
+    }
+
+    // Connected components of the undirected view, from a single sequential pass
+    // feeding every record into a union-find. component[v] is in [0, count).
+    // Returns the number of components.
+    int connectedComponents(std::vector<int> &component)
+    {
+        vector <int> parent (numVertices);
+        for (int v = 0; v < numVertices; v++) {
+            parent[v] = v;
+        }
+
+        EdgeFileReader reader(path, blockBytes);
+        for (size_t count = reader.readBlock(); count > 0; count = reader.readBlock()) {
+            for (size_t i = 0; i < count; i++) {
+                int a = findRoot(parent, reader.data()[i].source);
+                int b = findRoot(parent, reader.data()[i].target);
+                if (a != b) {
+                    parent[std::max(a, b)] = std::min(a, b); // Roots stay the smallest id
+                }
+            }
+        }
+        bytesRead = reader.totalBytesRead();
+
+        // Every root is smaller than the vertices below it, so one ascending pass labels all
+        int components = 0;
+        component.assign(numVertices, -1);
+        for (int v = 0; v < numVertices; v++) {
+            int root = findRoot(parent, v);
+            component[v] = root == v ? components++ : component[root];
+        }
+        return components;
+    }
+};
+
+//-------------------- SYNTHETIC GRAPH GENERATORS --------------------
+// Edge lists for benchmarks. Every generator is deterministic for a given seed;
+// edges are emitted once (u, v) and callers symmetrize for undirected graphs.
+class GraphGenerators
+{
+public:
+    // G(n, m): m edges with uniformly random endpoints (self-loops skipped)
+    static EdgeList erdosRenyi(int n, int64_t m, uint64_t seed = 1)
+    {
+        std::mt19937_64 rng(seed);
+        EdgeList edges;
+        edges.numVertices = n;
+        while ((int64_t)edges.numEdges() < m && n > 1) {
+            int u = rng() % n, v = rng() % n;
+            if (u != v) {
+                edges.sources.push_back(u);
+                edges.targets.push_back(v);
             }
         }
+        return edges;
     }
 
-    // Find strongly connected components using Kosaraju's algorithm
-    static std::vector<std::vector<int>> findStronglyConnectedComponents(const Graph &graph)
+    // R-MAT / Kronecker: 2^scale vertices, edgeFactor * 2^scale edges, each edge
+    // choosing a quadrant of the adjacency matrix with probabilities a, b, c, d
+    // at every level. Produces skewed, community-like degree distributions.
+    static EdgeList rmat(int scale, int edgeFactor, uint64_t seed = 1,
+                         double a = 0.57, double b = 0.19, double c = 0.19)
     {
-        // TODO: Implement Kosaraju's algorithm for finding SCCs
-        // 1. Check if graph is directed (algorithm only works for directed graphs)
-        // 2. First DFS pass:
-        //    a. For each unvisited vertex, run kosarajuFirstDFS
-        //    b. This fills the stack with vertices in order of decreasing finish times
-        // 3. Create a reversed graph by reversing all edges
-        // 4. Second DFS pass:
-        //    a. Process vertices in order from the stack (decreasing finish time)
-        //    b. For each unvisited vertex, run kosarajuSecondDFS to find a component
-        //    c. Add each component to the result
-        // 5. Return the list of strongly connected components
-        if (!graph.isDirected()) {
-            return {};
-        }
-
-        vector <bool> visited (graph.getNumVertices(), false);
-        stack <int> finishOrder;
+        std::mt19937_64 rng(seed);
+        std::uniform_real_distribution<double> coin(0.0, 1.0);
+        EdgeList edges;
+        edges.numVertices = 1 << scale;
+        int64_t m = (int64_t)edgeFactor << scale;
 
-        for (int v = 0; v < graph.getNumVertices(); v++) {
-            kosarajuFirstDFS(graph, v, visited, finishOrder);
+        // Scramble ids so the high-degree vertices are not all near 0
+        vector <int> label (edges.numVertices);
+        for (int v = 0; v < edges.numVertices; v++) {
+            label[v] = v;
         }
+        std::shuffle(label.begin(), label.end(), rng);
 
-        AdjacencyListGraph reversedGraph(graph.getNumVertices(), true);
-        for (int u = 0; u < graph.getNumVertices(); u++) {
-            for (int v : graph.getNeighbors(u)) {
-                reversedGraph.addEdge(v, u);
+        while ((int64_t)edges.numEdges() < m) {
+            int u = 0, v = 0;
+            for (int bit = 0; bit < scale; bit++) {
+                double r = coin(rng);
+                int down = r >= a + b;                      // quadrants c, d
+                int right = (r >= a && r < a + b) || r >= a + b + c; // quadrants b, d
+                u |= down << bit;
+                v |= right << bit;
+            }
+            if (u != v) {
+                edges.sources.push_back(label[u]);
+                edges.targets.push_back(label[v]);
             }
         }
+        return edges;
+    }
 
-        fill (visited.begin(), visited.end(), false);
-        vector <vector <int>> scc;
+    // rows x cols lattice, each vertex linked to its right and lower neighbor
+    static EdgeList grid(int rows, int cols)
+    {
+        EdgeList edges;
+        edges.numVertices = rows * cols;
+        for (int r = 0; r < rows; r++) {
+            for (int c = 0; c < cols; c++) {
+                int v = r * cols + c;
+                if (c + 1 < cols) {
+                    edges.sources.push_back(v);
+                    edges.targets.push_back(v + 1);
+                }
+                if (r + 1 < rows) {
+                    edges.sources.push_back(v);
+                    edges.targets.push_back(v + cols);
+                }
+            }
+        }
+        return edges;
+    }
 
-        while (!finishOrder.empty()) {
-            int current = finishOrder.top();
-            finishOrder.pop();
+    // Barabasi-Albert preferential attachment: each new vertex links to
+    // `edgesPerVertex` earlier vertices chosen proportionally to their degree
+    // (sampling a random endpoint of an existing edge), giving a power-law tail
+    static EdgeList powerLaw(int n, int edgesPerVertex, uint64_t seed = 1)
+    {
+        std::mt19937_64 rng(seed);
+        EdgeList edges;
+        edges.numVertices = n;
+        vector <int> endpoints; // Every vertex appears once per incident edge
 
-            if (!visited[current]) {
-                vector <int> components;
-                kosarajuSecondDFS (graph, current, visited, components);
-                scc.push_back(components);
+        for (int v = 1; v < n; v++) {
+            for (int k = 0; k < edgesPerVertex; k++) {
+                int target = endpoints.empty() ? 0 : endpoints[rng() % endpoints.size()];
+                if (target == v) {
+                    continue;
+                }
+                edges.sources.push_back(v);
+                edges.targets.push_back(target);
+                endpoints.push_back(v);
+                endpoints.push_back(target);
             }
         }
+        return edges;
+    }
 
-
-        return scc; // Placeholder
+    // Path 0 - 1 - ... - (n-1): maximal depth, stresses recursion and level counts
+    static EdgeList chain(int n)
+    {
+        EdgeList edges;
+        edges.numVertices = n;
+        for (int v = 0; v + 1 < n; v++) {
+            edges.sources.push_back(v);
+            edges.targets.push_back(v + 1);
+        }
+        return edges;
     }
 };
 
@@ -611,6 +3887,23 @@ void testGraphImplementations()
     std::cout << "Edge (0,1): " << (listGraph.hasEdge(0, 1) ? "exists" : "doesn't exist") << std::endl;
     std::cout << "Edge (4,0): " << (listGraph.hasEdge(4, 0) ? "exists" : "doesn't exist") << std::endl;
 
+    // Test mutations on copies so the algorithm tests below keep their inputs
+    std::cout << "\n======= Testing Graph Mutations =======\n";
+    AdjacencyMatrixGraph mutableMatrix = matrixGraph;
+    mutableMatrix.removeEdge(1, 4);
+    int addedVertex = mutableMatrix.addVertex();
+    mutableMatrix.addEdge(addedVertex, 2);
+    mutableMatrix.removeVertex(0); // Vertex 5 is renumbered to 0
+    std::cout << "Matrix after removeEdge(1,4), addVertex()=" << addedVertex
+              << ", addEdge(5,2), removeVertex(0):\n";
+    mutableMatrix.printGraph();
+
+    AdjacencyListGraph mutableList = listGraph;
+    mutableList.removeEdge(1, 3);
+    mutableList.removeVertex(2); // Vertex 4 is renumbered to 2
+    std::cout << "List after removeEdge(1,3), removeVertex(2):\n";
+    mutableList.printGraph();
+
     // Test graph traversal algorithms
     std::cout << "\n======= Testing Graph Algorithms =======\n";
 
@@ -623,15 +3916,58 @@ void testGraphImplementations()
     // BFS
     std::cout << "\nBFS starting from vertex 0:\n";
     GraphAlgorithms::BFS(listGraph, 0);
+
+    // Custom visitor on the traversal engine: DFS post-order and BFS edge count
+    struct OrderVisitor : TraversalVisitor
+    {
+        std::vector<int> finished;
+        int edges = 0;
+        void examineEdge(int /*source*/, int /*target*/) { edges++; }
+        void finishVertex(int vertex) { finished.push_back(vertex); }
+    };
+    OrderVisitor orderVisitor;
+    TraversalEngine::depthFirst(listGraph, 0, orderVisitor);
+    std::cout << "\nDFS finish order from vertex 0: ";
+    for (int vertex : orderVisitor.finished)
+    {
+        std::cout << vertex << " ";
+    }
+    std::cout << "(" << orderVisitor.edges << " edges examined)";
     
     // Connected Components (using undirected graph)
     std::cout << "\nConnected Components in undirected graph: "
               << GraphAlgorithms::findConnectedComponents(matrixGraph) << std::endl;
 
+    // Incremental connectivity (union-find) agrees with the DFS count
+    IncrementalConnectivity connectivity(matrixGraph);
+    std::cout << "Incremental connectivity components: " << connectivity.getComponentCount()
+              << ", after addVertex(): ";
+    connectivity.addVertex();
+    std::cout << connectivity.getComponentCount() << std::endl;
+
     // Bipartite Check
     std::cout << "Is the undirected graph bipartite? "
               << (GraphAlgorithms::isBipartite(matrixGraph) ? "Yes" : "No") << std::endl;
 
+    // Odd cycle witness and k-coloring
+    std::vector<int> colors, oddCycle;
+    if (!GraphColoring::twoColor(matrixGraph, colors, oddCycle))
+    {
+        std::cout << "Odd cycle witness: ";
+        for (int vertex : oddCycle)
+        {
+            std::cout << vertex << " - ";
+        }
+        std::cout << oddCycle.front() << std::endl;
+    }
+    int numColors = GraphColoring::jonesPlassmann(matrixGraph, colors);
+    std::cout << "Jones-Plassmann coloring with " << numColors << " colors: ";
+    for (size_t v = 0; v < colors.size(); v++)
+    {
+        std::cout << v << "=" << colors[v] << " ";
+    }
+    std::cout << (GraphColoring::isValidColoring(matrixGraph, colors) ? "(valid)" : "(invalid)") << std::endl;
+
     // Shortest Path
     std::cout << "\nShortest path from vertex 0 to 3:\n";
     std::vector<int> path = GraphAlgorithms::findShortestPath(matrixGraph, 0, 3);
@@ -641,6 +3977,36 @@ void testGraphImplementations()
     }
     std::cout << std::endl;
 
+    // Bidirectional BFS (meets in the middle, same path length)
+    std::cout << "Bidirectional shortest path from vertex 0 to 3:\n";
+    for (int vertex : GraphAlgorithms::findShortestPathBidirectional(matrixGraph, 0, 3))
+    {
+        std::cout << vertex << " ";
+    }
+    std::cout << std::endl;
+    std::cout << "Bidirectional shortest path from vertex 0 to 3 (directed list graph):\n";
+    for (int vertex : GraphAlgorithms::findShortestPathBidirectional(listGraph, 0, 3))
+    {
+        std::cout << vertex << " ";
+    }
+    std::cout << std::endl;
+
+    // Multi-source BFS (nearest facility among vertices 0 and 2)
+    std::vector<int> facilities = {0, 2};
+    std::vector<int> hops, nearest;
+    GraphAlgorithms::multiSourceBFS(matrixGraph, facilities, hops, nearest);
+    std::cout << "Nearest facility (0 or 2) per vertex: ";
+    for (size_t v = 0; v < hops.size(); v++)
+    {
+        std::cout << v << "->" << nearest[v] << "(" << hops[v] << ") ";
+    }
+    std::cout << "\nPath from nearest facility to vertex 4: ";
+    for (int vertex : GraphAlgorithms::findPathFromNearestSource(matrixGraph, facilities, 4))
+    {
+        std::cout << vertex << " ";
+    }
+    std::cout << std::endl;
+
     // Topological Sort (using directed graph)
     std::cout << "\nTopological Sort of the directed graph:\n";
     std::vector<int> topoOrder = GraphAlgorithms::topologicalSort(listGraph);
@@ -649,6 +4015,153 @@ void testGraphImplementations()
         std::cout << vertex << " ";
     }
     std::cout << std::endl;
+
+    // Level-wise topological sort: each line can be scheduled concurrently
+    std::cout << "Topological levels of the directed graph:\n";
+    std::vector<std::vector<int>> levels;
+    GraphAlgorithms::topologicalLevels(listGraph, levels);
+    for (size_t i = 0; i < levels.size(); i++)
+    {
+        std::cout << "Level " << i << ": ";
+        for (int vertex : levels[i])
+        {
+            std::cout << vertex << " ";
+        }
+        std::cout << std::endl;
+    }
+
+    // Triangles, clustering and k-cores: a 4-clique (0-3) with a triangle
+    // (3, 4, 5) hanging off it and a pendant vertex 6
+    std::cout << "\n======= Testing Triangles and Cores =======\n";
+    AdjacencyListGraph cliqueGraph(7);
+    for (int u = 0; u < 4; u++)
+    {
+        for (int v = u + 1; v < 4; v++)
+        {
+            cliqueGraph.addEdge(u, v);
+        }
+    }
+    cliqueGraph.addEdge(3, 4);
+    cliqueGraph.addEdge(4, 5);
+    cliqueGraph.addEdge(5, 3);
+    cliqueGraph.addEdge(5, 6);
+
+    std::vector<double> clustering;
+    double transitivity = GraphAlgorithms::clusteringCoefficients(cliqueGraph, clustering);
+    std::vector<int> core;
+    int degeneracy = GraphAlgorithms::coreNumbers(cliqueGraph, core);
+    std::cout << "Triangles: " << GraphAlgorithms::countTriangles(cliqueGraph)
+              << ", transitivity: " << transitivity << ", degeneracy: " << degeneracy << std::endl;
+    for (int v = 0; v < cliqueGraph.getNumVertices(); v++)
+    {
+        std::cout << "Vertex " << v << ": clustering " << clustering[v] << ", core " << core[v] << std::endl;
+    }
+
+    // The CSR overloads on a saved-and-mapped copy must agree with the list
+    const std::string trianglePath = "graph-template-triangles.mgraph";
+    cliqueGraph.saveBinary(trianglePath);
+    {
+        CSRGraph mappedClique = CSRGraph::open(trianglePath);
+        std::vector<double> mappedClustering;
+        double mappedTransitivity = GraphAlgorithms::clusteringCoefficients(mappedClique.view(), mappedClustering);
+        std::cout << "Mapped copy: triangles " << GraphAlgorithms::countTriangles(mappedClique.view())
+                  << ", transitivity " << mappedTransitivity
+                  << (mappedClustering == clustering ? ", same clustering" : ", DIFFERENT CLUSTERING") << std::endl;
+    }
+    std::remove(trianglePath.c_str());
+
+    // PageRank and label propagation on the same graph
+    std::cout << "\n======= Testing Iterative Engine =======\n";
+    {
+        IterativeEngine engine(cliqueGraph);
+        std::vector<IterativeEngine::IterationStats> stats;
+        std::vector<float> rank;
+        int rounds = engine.pageRank(rank, 0.85, 1e-6, 100, &stats);
+        std::cout << "PageRank converged in " << rounds << " rounds (last delta " << stats.back().delta << ", "
+                  << stats.back().milliseconds << " ms):\n";
+        for (size_t v = 0; v < rank.size(); v++)
+        {
+            std::cout << v << "=" << rank[v] << " ";
+        }
+
+        engine.personalizedPageRank({6}, rank);
+        std::cout << "\nPersonalized PageRank from vertex 6:\n";
+        for (size_t v = 0; v < rank.size(); v++)
+        {
+            std::cout << v << "=" << rank[v] << " ";
+        }
+
+        std::vector<int> community;
+        rounds = engine.labelPropagation(community, 100, &stats);
+        std::cout << "\nLabel propagation (" << rounds << " rounds): ";
+        for (size_t v = 0; v < community.size(); v++)
+        {
+            std::cout << v << "->" << community[v] << " ";
+        }
+        std::cout << std::endl;
+    }
+
+    // Partition a 6x6 grid three ways and check the multi-process BFS against BFS
+    std::cout << "\n======= Testing Graph Partitioning =======\n";
+    {
+        AdjacencyListGraph gridGraph = AdjacencyListGraph::fromCSR(buildCSR(GraphGenerators::grid(6, 6), true));
+        std::vector<int> reference, nearestSource, distance;
+        GraphAlgorithms::multiSourceBFS(gridGraph, {0}, reference, nearestSource);
+
+        const char *names[] = {"hash", "range", "fennel"};
+        PartitionStrategy strategies[] = {PartitionStrategy::Hash, PartitionStrategy::Range, PartitionStrategy::Fennel};
+        for (int i = 0; i < 3; i++)
+        {
+            std::vector<int> owner = GraphPartitioner::assign(gridGraph, 3, strategies[i]);
+            std::vector<GraphShard> shards = GraphPartitioner::split(gridGraph, owner, 3);
+            ShardedBFS::run(shards, 0, distance);
+            std::cout << names[i] << ": edge cut " << GraphPartitioner::edgeCut(gridGraph, owner)
+                      << " of 60 edges, ghosts";
+            for (const GraphShard &shard : shards)
+            {
+                std::cout << " " << shard.numGhosts();
+            }
+            std::cout << ", sharded BFS " << (distance == reference ? "matches" : "differs from") << " BFS\n";
+        }
+    }
+
+    // Semi-external BFS and components: a 6x6 grid plus a separate 4-vertex path,
+    // written unsorted to disk and sorted with a 1 KB budget to force several runs
+    std::cout << "\n======= Testing External-Memory BFS =======\n";
+    {
+        EdgeList edges = GraphGenerators::grid(6, 6);
+        edges.numVertices = 40;
+        for (int v = 36; v < 39; v++)
+        {
+            edges.sources.push_back(v + 1);
+            edges.targets.push_back(v);
+        }
+        std::mt19937 shuffleRng(7);
+        for (size_t e = edges.numEdges() - 1; e > 0; e--)
+        {
+            size_t other = shuffleRng() % (e + 1);
+            std::swap(edges.sources[e], edges.sources[other]);
+            std::swap(edges.targets[e], edges.targets[other]);
+        }
+
+        const std::string rawPath = "graph-template-edges.bin", sortedPath = "graph-template-edges.sorted.bin";
+        writeEdgeFile(rawPath, edges);
+        sortEdgeFile(rawPath, sortedPath, true, 1024);
+
+        ExternalMemoryGraph external(sortedPath, 256);
+        AdjacencyListGraph inMemory = AdjacencyListGraph::fromCSR(buildCSR(edges, true));
+        std::vector<int> reference, nearestSource, distance, component;
+        GraphAlgorithms::multiSourceBFS(inMemory, {0}, reference, nearestSource);
+        int levels = external.bfs(0, distance);
+        std::cout << "Sorted file: " << external.getNumEdges() << " records, " << external.getNumVertices()
+                  << " vertices\nExternal BFS: " << levels << " levels, " << external.lastBytesRead()
+                  << " bytes read, " << (distance == reference ? "matches" : "differs from") << " in-memory BFS\n";
+        std::cout << "External connected components: " << external.connectedComponents(component)
+                  << " (in memory: " << GraphAlgorithms::findConnectedComponents(inMemory) << ")\n";
+        std::remove(rawPath.c_str());
+        std::remove(sortedPath.c_str());
+    }
+
     // Test Strongly Connected Components (using directed graph)
     std::cout << "\n======= Testing Strongly Connected Components =======\n";
     AdjacencyListGraph sccGraph(8, true);
@@ -670,6 +4183,32 @@ void testGraphImplementations()
 
     std::vector<std::vector<int>> sccs = GraphAlgorithms::findStronglyConnectedComponents(sccGraph);
 
+    // Incremental SCCs: insert the same edges one by one
+    IncrementalSCC incrementalScc(8);
+    std::cout << "Incremental SCC count after each edge: ";
+    for (int u = 0; u < sccGraph.getNumVertices(); u++)
+    {
+        for (int v : sccGraph.getNeighbors(u))
+        {
+            incrementalScc.addEdge(u, v);
+            std::cout << incrementalScc.getComponentCount() << " ";
+        }
+    }
+    std::cout << "\n0 and 2 strongly connected? " << (incrementalScc.stronglyConnected(0, 2) ? "Yes" : "No")
+              << ", 2 and 3? " << (incrementalScc.stronglyConnected(2, 3) ? "Yes" : "No") << std::endl;
+
+    // Cycle detection: the SCC graph is not a DAG
+    std::vector<int> order, cycle;
+    if (!GraphAlgorithms::topologicalSortKahn(sccGraph, order, &cycle))
+    {
+        std::cout << "Topological sort failed, cycle found: ";
+        for (int vertex : cycle)
+        {
+            std::cout << vertex << " -> ";
+        }
+        std::cout << cycle.front() << std::endl;
+    }
+
     std::cout << "Strongly Connected Components:\n";
     for (size_t i = 0; i < sccs.size(); i++)
     {
@@ -680,10 +4219,478 @@ void testGraphImplementations()
         }
         std::cout << std::endl;
     }
+
+    // Test the dynamic graph: a pinned snapshot is unaffected by later batches
+    std::cout << "\n======= Testing Dynamic Graph Snapshots =======\n";
+    DynamicGraph dynamicGraph(5, true);
+    dynamicGraph.applyBatch({{0, 1, true}, {1, 2, true}, {2, 3, true}});
+    DynamicGraph::Snapshot before = dynamicGraph.snapshot();
+
+    std::thread writerA([&]() { dynamicGraph.applyBatch({{3, 4, true}, {4, 0, true}}); });
+    std::thread writerB([&]() { dynamicGraph.applyBatch({{1, 2, false}, {1, 3, true}}); });
+    writerA.join();
+    writerB.join();
+    DynamicGraph::Snapshot after = dynamicGraph.snapshot();
+
+    std::cout << "Snapshot v" << before.versionNumber() << " (BFS from 0): ";
+    GraphAlgorithms::BFS(before, 0);
+    std::cout << "\nLatest snapshot:\n";
+    after.printGraph();
+    std::cout << "SCCs in latest snapshot: " << GraphAlgorithms::findStronglyConnectedComponents(after).size()
+              << std::endl;
+
+    // Test vertex reordering (relabel, then map the new ids back to the originals)
+    std::cout << "\n======= Testing Vertex Reordering =======\n";
+    std::vector<int> newId = VertexReordering::reverseCuthillMcKee(sccGraph);
+    std::vector<int> oldId = VertexReordering::inverse(newId);
+    AdjacencyListGraph reordered = VertexReordering::relabel(sccGraph, newId);
+    std::cout << "RCM new id -> original id: ";
+    for (size_t i = 0; i < oldId.size(); i++)
+    {
+        std::cout << i << "=" << oldId[i] << " ";
+    }
+    std::cout << "\nReordered graph:\n";
+    reordered.printGraph();
+    std::cout << "SCCs after reordering (original ids): ";
+    for (const std::vector<int> &component : GraphAlgorithms::findStronglyConnectedComponents(reordered))
+    {
+        std::cout << "{ ";
+        for (int vertex : component)
+        {
+            std::cout << oldId[vertex] << " ";
+        }
+        std::cout << "} ";
+    }
+    std::cout << std::endl;
+
+    // Test the binary graph format (round trip through a memory-mapped file)
+    std::cout << "\n======= Testing Binary Graph Format =======\n";
+    const std::string binaryPath = "graph-template-test.mgraph";
+    sccGraph.saveBinary(binaryPath);
+    {
+        CSRGraph mappedGraph = CSRGraph::open(binaryPath);
+        std::cout << "Mapped graph (" << mappedGraph.getNumVertices() << " vertices, "
+                  << (mappedGraph.isDirected() ? "directed" : "undirected") << "):\n";
+        mappedGraph.printGraph();
+        std::cout << "Edge (6,7): " << (mappedGraph.hasEdge(6, 7) ? "exists" : "doesn't exist") << std::endl;
+    }
+
+    // Flip one payload byte: the checksum must reject the file
+    FILE *corrupt = std::fopen(binaryPath.c_str(), "r+b");
+    if (corrupt) {
+        std::fseek(corrupt, 100, SEEK_SET);
+        int byte = std::fgetc(corrupt);
+        std::fseek(corrupt, 100, SEEK_SET);
+        std::fputc(byte ^ 0xFF, corrupt);
+        std::fclose(corrupt);
+    }
+    try {
+        CSRGraph::open(binaryPath);
+        std::cout << "Error: corrupted file was accepted\n";
+    } catch (const std::runtime_error &e) {
+        std::cout << "Corrupted file rejected: " << e.what() << std::endl;
+    }
+    std::remove(binaryPath.c_str());
+}
+
+// Benchmark traversal speed before and after reordering. The input is a directed
+// grid (mostly two-way streets, some one-way) whose vertex ids are randomly
+// shuffled, the typical state of ids coming out of a production dump.
+void benchmarkReordering(int side)
+{
+    int n = side * side;
+    std::mt19937 rng(42);
+    std::vector<int> shuffled(n);
+    for (int v = 0; v < n; v++) {
+        shuffled[v] = v;
+    }
+    std::shuffle(shuffled.begin(), shuffled.end(), rng);
+
+    EdgeList edges;
+    edges.numVertices = n;
+    auto addStreet = [&](int a, int b) {
+        // 80% two-way, 10% one-way in each direction
+        int direction = rng() % 10;
+        if (direction != 9) {
+            edges.sources.push_back(shuffled[a]);
+            edges.targets.push_back(shuffled[b]);
+        }
+        if (direction != 8) {
+            edges.sources.push_back(shuffled[b]);
+            edges.targets.push_back(shuffled[a]);
+        }
+    };
+    for (int r = 0; r < side; r++) {
+        for (int c = 0; c < side; c++) {
+            if (c + 1 < side) addStreet(r * side + c, r * side + c + 1);
+            if (r + 1 < side) addStreet(r * side + c, (r + 1) * side + c);
+        }
+    }
+    AdjacencyListGraph original = AdjacencyListGraph::fromCSR(buildCSR(edges, false), true);
+
+    auto millisSince = [](chrono::steady_clock::time_point start) {
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    };
+
+    // Full BFS without output on the traversal engine behind GraphAlgorithms::BFS
+    struct CountVisitor : TraversalVisitor
+    {
+        size_t discovered = 0;
+        void discoverVertex(int /*vertex*/) { discovered++; }
+    };
+    auto bfs = [](const AdjacencyListGraph &graph, int source) {
+        CountVisitor counter;
+        TraversalEngine::breadthFirst(graph, source, counter);
+        return counter.discovered;
+    };
+
+    std::cout << "Reordering benchmark: " << side << "x" << side << " grid, " << n << " vertices, "
+              << edges.numEdges() << " edges\n";
+    std::cout << "Ordering          reorder ms     BFS ms     SCC ms   BFS speedup   SCC speedup\n";
+
+    double baseBFS = 0, baseSCC = 0;
+    const char *names[] = {"Original", "Degree sort", "RCM", "Gorder"};
+    for (int method = 0; method < 4; method++) {
+        auto start = chrono::steady_clock::now();
+        std::vector<int> newId;
+        if (method == 1) newId = VertexReordering::degreeSort(original);
+        if (method == 2) newId = VertexReordering::reverseCuthillMcKee(original);
+        if (method == 3) newId = VertexReordering::gorder(original);
+        AdjacencyListGraph graph = method == 0 ? original : VertexReordering::relabel(original, newId);
+        double reorderMs = millisSince(start);
+
+        int source = method == 0 ? 0 : newId[0];
+        start = chrono::steady_clock::now();
+        size_t reached = bfs(graph, source);
+        double bfsMs = millisSince(start);
+
+        start = chrono::steady_clock::now();
+        size_t components = GraphAlgorithms::findStronglyConnectedComponents(graph).size();
+        double sccMs = millisSince(start);
+
+        if (method == 0) {
+            baseBFS = bfsMs;
+            baseSCC = sccMs;
+        }
+        std::printf("%-14s %11.1f %10.1f %10.1f %12.2fx %12.2fx   (reached %zu, %zu SCCs)\n", names[method],
+                    method == 0 ? 0.0 : reorderMs, bfsMs, sccMs, baseBFS / bfsMs, baseSCC / sccMs, reached, components);
+    }
+}
+
+// Peak resident set size of this process in KB (0 where it cannot be queried)
+long peakMemoryKB()
+{
+#if defined(__unix__) || defined(__APPLE__)
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+#else
+    return 0;
+#endif
+}
+
+// Time BFS, DFS, components, SCC, bipartite check and topological sort on the
+// synthetic generators, for both graph representations. `scale` multiplies the
+// default sizes (about 2^16 vertices for the adjacency lists).
+void runGraphBenchmarks(int scale)
+{
+    struct Workload
+    {
+        std::string name;
+        EdgeList edges;
+    };
+
+    int n = 65536 * scale;
+    int side = (int)std::sqrt((double)n);
+    int rmatScale = 16;
+    while ((1 << rmatScale) < n) {
+        rmatScale++;
+    }
+
+    std::vector<Workload> workloads;
+    workloads.push_back({"erdos-renyi", GraphGenerators::erdosRenyi(n, 8LL * n)});
+    workloads.push_back({"rmat", GraphGenerators::rmat(rmatScale, 8)});
+    workloads.push_back({"grid", GraphGenerators::grid(side, side)});
+    workloads.push_back({"power-law", GraphGenerators::powerLaw(n, 4)});
+    workloads.push_back({"chain", GraphGenerators::chain(n)});
+
+    // The matrix representation is O(V^2); benchmark it on a vertex-induced prefix
+    const int matrixVertices = 4096;
+
+    auto millisSince = [](chrono::steady_clock::time_point start) {
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    };
+
+    std::printf("%-12s %-7s %-10s %9s %10s %12s %13s\n", "graph", "repr", "directed", "algorithm", "ms",
+                "Medges/s", "peak RSS MB");
+
+    for (const Workload &workload : workloads) {
+        for (int isDirected = 0; isDirected <= 1; isDirected++) {
+            for (int useMatrix = 0; useMatrix <= 1; useMatrix++) {
+                std::unique_ptr<Graph> graph;
+                std::unique_ptr<Graph> dag; // Same edges oriented low -> high id, for topological sort
+                EdgeList oriented;
+
+                if (!useMatrix) {
+                    graph.reset(new AdjacencyListGraph(
+                        AdjacencyListGraph::fromCSR(buildCSR(workload.edges, !isDirected), isDirected)));
+                    oriented = workload.edges;
+                } else {
+                    int m = std::min(matrixVertices, workload.edges.numVertices);
+                    AdjacencyMatrixGraph *matrix = new AdjacencyMatrixGraph(m, isDirected);
+                    graph.reset(matrix);
+                    oriented.numVertices = m;
+                    for (size_t e = 0; e < workload.edges.numEdges(); e++) {
+                        if (workload.edges.sources[e] < m && workload.edges.targets[e] < m) {
+                            matrix->addEdge(workload.edges.sources[e], workload.edges.targets[e]);
+                            oriented.sources.push_back(workload.edges.sources[e]);
+                            oriented.targets.push_back(workload.edges.targets[e]);
+                        }
+                    }
+                }
+
+                if (isDirected) {
+                    for (size_t e = 0; e < oriented.numEdges(); e++) {
+                        if (oriented.sources[e] > oriented.targets[e]) {
+                            std::swap(oriented.sources[e], oriented.targets[e]);
+                        }
+                    }
+                    if (!useMatrix) {
+                        dag.reset(new AdjacencyListGraph(AdjacencyListGraph::fromCSR(buildCSR(oriented, false), true)));
+                    } else {
+                        AdjacencyMatrixGraph *matrix = new AdjacencyMatrixGraph(oriented.numVertices, true);
+                        for (size_t e = 0; e < oriented.numEdges(); e++) {
+                            matrix->addEdge(oriented.sources[e], oriented.targets[e]);
+                        }
+                        dag.reset(matrix);
+                    }
+                }
+
+                // Adjacency entries actually scanned by a full traversal
+                long long entries = 0;
+                for (int v = 0; v < graph->getNumVertices(); v++) {
+                    entries += graph->getNeighbors(v).size();
+                }
+
+                auto report = [&](const char *algorithm, double ms) {
+                    std::printf("%-12s %-7s %-10s %9s %10.2f %12.1f %13.1f\n", workload.name.c_str(),
+                                useMatrix ? "matrix" : "list", isDirected ? "yes" : "no", algorithm, ms,
+                                ms > 0 ? entries / ms / 1000.0 : 0.0, peakMemoryKB() / 1024.0);
+                };
+
+                TraversalVisitor visitor;
+                std::vector<char> visited(graph->getNumVertices(), 0);
+                auto start = chrono::steady_clock::now();
+                TraversalEngine::dispatch(*graph, [&](const auto &g) {
+                    for (int v = 0; v < g.getNumVertices(); v++) {
+                        TraversalEngine::breadthFirst(g, v, visitor, visited);
+                    }
+                });
+                report("BFS", millisSince(start));
+
+                std::fill(visited.begin(), visited.end(), 0);
+                start = chrono::steady_clock::now();
+                TraversalEngine::dispatch(*graph, [&](const auto &g) {
+                    for (int v = 0; v < g.getNumVertices(); v++) {
+                        TraversalEngine::depthFirst(g, v, visitor, visited);
+                    }
+                });
+                report("DFS", millisSince(start));
+
+                if (!isDirected) {
+                    start = chrono::steady_clock::now();
+                    GraphAlgorithms::findConnectedComponents(*graph);
+                    report("CC", millisSince(start));
+
+                    start = chrono::steady_clock::now();
+                    GraphAlgorithms::isBipartite(*graph);
+                    report("bipartite", millisSince(start));
+                } else {
+                    start = chrono::steady_clock::now();
+                    GraphAlgorithms::findStronglyConnectedComponents(*graph);
+                    report("SCC", millisSince(start));
+
+                    start = chrono::steady_clock::now();
+                    GraphAlgorithms::topologicalSort(*dag);
+                    report("topo", millisSince(start));
+                }
+            }
+        }
+    }
+}
+
+// Partition quality and multi-process BFS time for 1..maxShards shards on an
+// R-MAT graph with 2^scale vertices, for each partitioning strategy
+void benchmarkSharding(int scale, int maxShards)
+{
+    AdjacencyListGraph graph =
+        AdjacencyListGraph::fromCSR(buildCSR(GraphGenerators::rmat(scale, 16), false), true);
+    int source = 0; // Start from the hub so the search reaches the giant component
+    for (int v = 0; v < graph.getNumVertices(); v++) {
+        if (graph.neighbors(v).size() > graph.neighbors(source).size()) {
+            source = v;
+        }
+    }
+    std::vector<int> reference, nearestSource, distance;
+    GraphAlgorithms::multiSourceBFS(graph, {source}, reference, nearestSource);
+
+    const char *names[] = {"hash", "range", "fennel"};
+    PartitionStrategy strategies[] = {PartitionStrategy::Hash, PartitionStrategy::Range, PartitionStrategy::Fennel};
+    std::printf("%-8s %6s %12s %10s %12s %10s\n", "strategy", "shards", "edge cut", "ghosts", "BFS ms", "correct");
+    for (int i = 0; i < 3; i++) {
+        for (int k = 1; k <= maxShards; k *= 2) {
+            std::vector<int> owner = GraphPartitioner::assign(graph, k, strategies[i]);
+            std::vector<GraphShard> shards = GraphPartitioner::split(graph, owner, k);
+            long long ghosts = 0;
+            for (const GraphShard &shard : shards) {
+                ghosts += shard.numGhosts();
+            }
+
+            auto start = chrono::steady_clock::now();
+            ShardedBFS::run(shards, source, distance);
+            double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+            std::printf("%-8s %6d %12lld %10lld %12.2f %10s\n", names[i], k,
+                        (long long)GraphPartitioner::edgeCut(graph, owner), ghosts, ms,
+                        distance == reference ? "yes" : "NO");
+        }
+    }
+}
+
+// Semi-external BFS and components on an R-MAT graph written to disk, compared
+// with the in-memory versions. `memoryMB` bounds the sort and the read blocks.
+void benchmarkExternal(int scale, int memoryMB)
+{
+    const std::string rawPath = "graph-bench-edges.bin", sortedPath = "graph-bench-edges.sorted.bin";
+    size_t budget = (size_t)memoryMB << 20;
+    EdgeList edges = GraphGenerators::rmat(scale, 16);
+    writeEdgeFile(rawPath, edges);
+
+    auto millisSince = [](chrono::steady_clock::time_point start) {
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    };
+
+    auto start = chrono::steady_clock::now();
+    sortEdgeFile(rawPath, sortedPath, true, budget);
+    std::printf("sort (%d MB budget): %.1f ms\n", memoryMB, millisSince(start));
+
+    start = chrono::steady_clock::now();
+    ExternalMemoryGraph external(sortedPath, budget / 4, edges.numVertices);
+    std::printf("index: %.1f ms, %d vertices, %lld records\n", millisSince(start), external.getNumVertices(),
+                (long long)external.getNumEdges());
+
+    AdjacencyListGraph inMemory = AdjacencyListGraph::fromCSR(buildCSR(edges, true));
+    int source = 0;
+    for (int v = 0; v < inMemory.getNumVertices(); v++) {
+        if (inMemory.neighbors(v).size() > inMemory.neighbors(source).size()) {
+            source = v;
+        }
+    }
+
+    std::vector<int> distance, reference, nearestSource, component;
+    start = chrono::steady_clock::now();
+    int levels = external.bfs(source, distance);
+    std::printf("external BFS: %.1f ms, %d levels, %.1f MB read\n", millisSince(start), levels,
+                external.lastBytesRead() / 1048576.0);
+    start = chrono::steady_clock::now();
+    GraphAlgorithms::multiSourceBFS(inMemory, {source}, reference, nearestSource);
+    std::printf("in-memory BFS: %.1f ms (%s)\n", millisSince(start), distance == reference ? "same distances" : "MISMATCH");
+
+    start = chrono::steady_clock::now();
+    int components = external.connectedComponents(component);
+    std::printf("external components: %.1f ms, %d components\n", millisSince(start), components);
+    start = chrono::steady_clock::now();
+    int expected = GraphAlgorithms::findConnectedComponents(inMemory);
+    std::printf("in-memory components: %.1f ms, %d components\n", millisSince(start), expected);
+
+    std::remove(rawPath.c_str());
+    std::remove(sortedPath.c_str());
+}
+
+// Load a graph dump given on the command line and report basic statistics
+// (.mgraph files are memory-mapped; other files are parsed as edge lists).
+int runOnEdgeFile(const std::string &path, bool isDirected, const std::string &savePath)
+{
+    auto start = chrono::steady_clock::now();
+    bool isBinaryGraph = path.size() > 7 && path.compare(path.size() - 7, 7, ".mgraph") == 0;
+    std::unique_ptr<Graph> loadedGraph;
+    if (isBinaryGraph) {
+        loadedGraph.reset(new CSRGraph(CSRGraph::open(path)));
+    } else {
+        AdjacencyListGraph *listGraph = new AdjacencyListGraph(AdjacencyListGraph::fromFile(path, isDirected));
+        loadedGraph.reset(listGraph);
+        if (!savePath.empty()) {
+            listGraph->saveBinary(savePath);
+        }
+    }
+    const Graph &graph = *loadedGraph;
+    isDirected = graph.isDirected();
+    auto loaded = chrono::steady_clock::now();
+
+    long long numEdges = 0;
+    for (int v = 0; v < graph.getNumVertices(); v++) {
+        numEdges += graph.getNeighbors(v).size();
+    }
+
+    std::cout << "Loaded " << path << ": " << graph.getNumVertices() << " vertices, "
+              << numEdges << " adjacency entries in "
+              << chrono::duration<double, milli>(loaded - start).count() << " ms\n";
+
+    if (!isDirected) {
+        std::cout << "Connected Components: " << GraphAlgorithms::findConnectedComponents(graph) << std::endl;
+    }
+    return 0;
 }
 
-int main()
+int main(int argc, char *argv[])
 {
+    // Usage: graph-implementation-template [edge-file [--directed] [--save graph.mgraph]]
+    //        graph-implementation-template --bench [scale]
+    //        graph-implementation-template --bench-shards [rmat-scale [max-shards]]
+    //        graph-implementation-template --bench-external [rmat-scale [memory-MB]]
+    //        graph-implementation-template --bench-reorder [grid-side]
+    if (argc > 1 && std::string(argv[1]) == "--bench") {
+        runGraphBenchmarks(argc > 2 ? std::stoi(argv[2]) : 1);
+        return 0;
+    }
+
+    if (argc > 1 && std::string(argv[1]) == "--bench-shards") {
+        benchmarkSharding(argc > 2 ? std::stoi(argv[2]) : 18, argc > 3 ? std::stoi(argv[3]) : 8);
+        return 0;
+    }
+
+    if (argc > 1 && std::string(argv[1]) == "--bench-external") {
+        benchmarkExternal(argc > 2 ? std::stoi(argv[2]) : 20, argc > 3 ? std::stoi(argv[3]) : 64);
+        return 0;
+    }
+
+    if (argc > 1 && std::string(argv[1]) == "--bench-reorder") {
+        benchmarkReordering(argc > 2 ? std::stoi(argv[2]) : 1000);
+        return 0;
+    }
+
+    if (argc > 1) {
+        bool isDirected = false;
+        std::string savePath;
+        for (int i = 2; i < argc; i++) {
+            std::string arg = argv[i];
+            if (arg == "--directed") {
+                isDirected = true;
+            } else if (arg == "--save" && i + 1 < argc) {
+                savePath = argv[++i];
+            }
+        }
+        try {
+            return runOnEdgeFile(argv[1], isDirected, savePath);
+        } catch (const std::exception &e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
     testGraphImplementations();
     return 0;
 }
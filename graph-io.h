@@ -0,0 +1,1202 @@
+// Graph I/O Helpers
+// Shared by graph-implementation-template.cpp, shortest-path-template.cpp and template_dp_floyd.cpp.
+// Loads edge lists from memory-mapped files (SNAP, DIMACS, Matrix Market, raw binary),
+// parses the text formats in parallel chunks and builds CSR arrays directly,
+// without going through iostream. Also holds the distance arithmetic the
+// shortest-path templates share.
+
+#ifndef GRAPH_IO_H
+#define GRAPH_IO_H
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define GRAPH_IO_HAS_MMAP 1
+#endif
+
+//-------------------- MEMORY-MAPPED FILE --------------------
+// Read-only view of a whole file. Uses mmap where available and falls back
+// to reading the file into memory on other platforms.
+class MappedFile
+{
+private:
+    const char *bytes = nullptr;
+    size_t length = 0;
+    bool mapped = false;
+    std::vector<char> fallback;
+
+    void release()
+    {
+#ifdef GRAPH_IO_HAS_MMAP
+        if (mapped) {
+            munmap(const_cast<char *>(bytes), length);
+        }
+#endif
+        bytes = nullptr;
+        length = 0;
+        mapped = false;
+        fallback.clear();
+    }
+
+public:
+    MappedFile() {}
+
+    explicit MappedFile(const std::string &path)
+    {
+#ifdef GRAPH_IO_HAS_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open file: " + path);
+        }
+
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Cannot stat file: " + path);
+        }
+
+        length = static_cast<size_t>(st.st_size);
+        if (length > 0) {
+            void *p = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("Cannot mmap file: " + path);
+            }
+            madvise(p, length, MADV_SEQUENTIAL);
+            bytes = static_cast<const char *>(p);
+            mapped = true;
+        }
+        ::close(fd);
+#else
+        FILE *f = std::fopen(path.c_str(), "rb");
+        if (!f) {
+            throw std::runtime_error("Cannot open file: " + path);
+        }
+        std::fseek(f, 0, SEEK_END);
+        long size = std::ftell(f);
+        std::fseek(f, 0, SEEK_SET);
+        fallback.resize(size > 0 ? static_cast<size_t>(size) : 0);
+        if (!fallback.empty() && std::fread(fallback.data(), 1, fallback.size(), f) != fallback.size()) {
+            std::fclose(f);
+            throw std::runtime_error("Cannot read file: " + path);
+        }
+        std::fclose(f);
+        bytes = fallback.data();
+        length = fallback.size();
+#endif
+    }
+
+    ~MappedFile()
+    {
+        release();
+    }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    MappedFile(MappedFile &&other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    MappedFile &operator=(MappedFile &&other) noexcept
+    {
+        if (this != &other) {
+            release();
+            fallback = std::move(other.fallback);
+            mapped = other.mapped;
+            length = other.length;
+            bytes = mapped ? other.bytes : fallback.data();
+            other.bytes = nullptr;
+            other.length = 0;
+            other.mapped = false;
+        }
+        return *this;
+    }
+
+    const char *data() const
+    {
+        return bytes;
+    }
+
+    size_t size() const
+    {
+        return length;
+    }
+};
+
+//-------------------- EDGE LIST AND CSR --------------------
+// Edges as parallel arrays. Vertex ids are always 0-based after loading.
+struct EdgeList
+{
+    int numVertices = 0;
+    bool weighted = false;
+    bool symmetric = false; // Matrix Market "symmetric": only one triangle is stored
+    std::vector<int> sources;
+    std::vector<int> targets;
+    std::vector<int> weights; // Empty when the file carries no weights
+
+    size_t numEdges() const
+    {
+        return sources.size();
+    }
+};
+
+// Compressed sparse row arrays: the neighbors of v are
+// targets[offsets[v]] .. targets[offsets[v + 1] - 1].
+struct CSRData
+{
+    int numVertices = 0;
+    std::vector<int64_t> offsets;
+    std::vector<int> targets;
+    std::vector<int> weights; // Same length as targets, or empty when unweighted
+
+    int64_t numEdges() const
+    {
+        return static_cast<int64_t>(targets.size());
+    }
+
+    int64_t degree(int vertex) const
+    {
+        return offsets[vertex + 1] - offsets[vertex];
+    }
+};
+
+// Non-owning CSR arrays, e.g. pointing into a memory-mapped binary graph file.
+struct CSRView
+{
+    int numVertices = 0;
+    int64_t numEdges = 0;
+    const int64_t *offsets = nullptr;
+    const int *targets = nullptr;
+    const int *weights = nullptr; // nullptr when unweighted
+
+    int64_t degree(int vertex) const
+    {
+        return offsets[vertex + 1] - offsets[vertex];
+    }
+};
+
+inline CSRView viewOf(const CSRData &csr)
+{
+    CSRView view;
+    view.numVertices = csr.numVertices;
+    view.numEdges = csr.numEdges();
+    view.offsets = csr.offsets.data();
+    view.targets = csr.targets.data();
+    view.weights = csr.weights.empty() ? nullptr : csr.weights.data();
+    return view;
+}
+
+//-------------------- EDGE LIST LOADER --------------------
+enum class EdgeFileFormat
+{
+    Auto,
+    SNAP,         // "u v [w]" per line, '#' comments, 0-based ids
+    DIMACS,       // "p sp n m" header, "a u v w" arcs, 'c' comments, 1-based ids
+    MatrixMarket, // "%%MatrixMarket matrix coordinate ..." banner, "rows cols nnz", "i j [v]", 1-based
+    Binary        // Raw little-endian int32 records: (u, v) or (u, v, w), 0-based ids
+};
+
+class EdgeListLoader
+{
+private:
+    struct ChunkResult
+    {
+        std::vector<int> sources;
+        std::vector<int> targets;
+        std::vector<int> weights;
+        int maxVertex = -1;
+        bool sawWeight = false;
+        std::exception_ptr error; // Rethrown by load() once every worker has joined
+    };
+
+    static bool isBlank(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    // Parse a (possibly signed, possibly fractional) number; fractional values are
+    // rounded. Values outside the range of long long throw std::runtime_error.
+    static bool parseNumber(const char *&p, const char *end, long long &value)
+    {
+        while (p < end && isBlank(*p)) {
+            p++;
+        }
+        if (p >= end || *p == '\n') {
+            return false;
+        }
+
+        bool negative = false;
+        if (*p == '-' || *p == '+') {
+            negative = (*p == '-');
+            p++;
+        }
+
+        if (p >= end || ((*p < '0' || *p > '9') && *p != '.')) {
+            return false;
+        }
+
+        const long long limit = std::numeric_limits<long long>::max();
+        long long integer = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            if (integer > (limit - (*p - '0')) / 10) {
+                throw std::runtime_error("Number too large in edge file");
+            }
+            integer = integer * 10 + (*p - '0');
+            p++;
+        }
+
+        // Round fractional / exponent weights (Matrix Market real matrices)
+        if (p < end && (*p == '.' || *p == 'e' || *p == 'E')) {
+            double fraction = 0.0, scale = 0.1;
+            if (*p == '.') {
+                p++;
+                while (p < end && *p >= '0' && *p <= '9') {
+                    fraction += (*p - '0') * scale;
+                    scale *= 0.1;
+                    p++;
+                }
+            }
+            double real = integer + fraction;
+            if (p < end && (*p == 'e' || *p == 'E')) {
+                p++;
+                long long exponent = 0;
+                const char *q = p;
+                if (parseNumber(q, end, exponent)) {
+                    p = q;
+                    real *= std::pow(10.0, static_cast<double>(exponent));
+                }
+            }
+            // 2^63 is exactly representable; anything at or above it would not convert
+            if (!(real + 0.5 < 9223372036854775808.0)) {
+                throw std::runtime_error("Number too large in edge file");
+            }
+            integer = static_cast<long long>(real + 0.5);
+        }
+
+        value = negative ? -integer : integer;
+        return true;
+    }
+
+    static const char *nextLine(const char *p, const char *end)
+    {
+        const char *newline = static_cast<const char *>(std::memchr(p, '\n', end - p));
+        return newline ? newline + 1 : end;
+    }
+
+    static void parseChunk(const char *begin, const char *end, EdgeFileFormat format, ChunkResult &out)
+    {
+        int base = (format == EdgeFileFormat::SNAP) ? 0 : 1;
+        const char *p = begin;
+
+        while (p < end) {
+            const char *lineEnd = nextLine(p, end);
+            const char *q = p;
+            while (q < lineEnd && isBlank(*q)) {
+                q++;
+            }
+
+            bool isData;
+            if (format == EdgeFileFormat::DIMACS) {
+                isData = (q < lineEnd && *q == 'a');
+                q++;
+            } else {
+                isData = (q < lineEnd && *q != '#' && *q != '%' && *q != '\n');
+            }
+
+            // Ids stay below INT_MAX so that the vertex count fits in an int too
+            auto vertexId = [base](long long id) {
+                if (id < base || id - base >= std::numeric_limits<int>::max()) {
+                    throw std::runtime_error("Vertex id out of range in edge file: " + std::to_string(id));
+                }
+                return static_cast<int>(id - base);
+            };
+
+            long long u, v, w;
+            if (isData && parseNumber(q, lineEnd, u) && parseNumber(q, lineEnd, v)) {
+                int source = vertexId(u);
+                int target = vertexId(v);
+                int weight = 1;
+                if (parseNumber(q, lineEnd, w)) {
+                    if (w < std::numeric_limits<int>::min() || w > std::numeric_limits<int>::max()) {
+                        throw std::runtime_error("Edge weight out of range in edge file: " + std::to_string(w));
+                    }
+                    weight = static_cast<int>(w);
+                    out.sawWeight = true;
+                }
+                out.sources.push_back(source);
+                out.targets.push_back(target);
+                out.weights.push_back(weight);
+                out.maxVertex = std::max(out.maxVertex, std::max(source, target));
+            }
+
+            p = lineEnd;
+        }
+    }
+
+    static EdgeFileFormat detectFormat(const std::string &path, const char *data, size_t size)
+    {
+        auto endsWith = [&](const std::string &suffix) {
+            return path.size() >= suffix.size() && path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0;
+        };
+
+        if (endsWith(".bin") || endsWith(".el32")) {
+            return EdgeFileFormat::Binary;
+        }
+        if (endsWith(".mtx") || (size >= 14 && std::memcmp(data, "%%MatrixMarket", 14) == 0)) {
+            return EdgeFileFormat::MatrixMarket;
+        }
+        if (endsWith(".gr")) {
+            return EdgeFileFormat::DIMACS;
+        }
+
+        // Sniff the first non-comment line for a DIMACS problem line
+        const char *p = data, *end = data + size;
+        while (p < end) {
+            if (*p == 'p') {
+                return EdgeFileFormat::DIMACS;
+            }
+            if (*p != 'c' && *p != '#' && *p != '%' && *p != '\n') {
+                break;
+            }
+            p = nextLine(p, end);
+        }
+        return EdgeFileFormat::SNAP;
+    }
+
+    // Consume header lines; returns the offset where edge data starts and fills declared sizes.
+    static size_t parseHeader(EdgeFileFormat format, const char *data, size_t size, EdgeList &result,
+                              long long &declaredVertices, long long &declaredEdges)
+    {
+        const char *p = data, *end = data + size;
+        declaredVertices = -1;
+        declaredEdges = -1;
+
+        if (format == EdgeFileFormat::MatrixMarket) {
+            const char *lineEnd = nextLine(p, end);
+            std::string banner(p, lineEnd);
+            std::transform(banner.begin(), banner.end(), banner.begin(), ::tolower);
+            if (banner.compare(0, 14, "%%matrixmarket") != 0 || banner.find("coordinate") == std::string::npos) {
+                throw std::runtime_error("Only coordinate Matrix Market files are supported");
+            }
+            result.symmetric = banner.find("symmetric") != std::string::npos;
+            result.weighted = banner.find("pattern") == std::string::npos;
+            p = lineEnd;
+
+            while (p < end && (*p == '%' || *p == '\n')) {
+                p = nextLine(p, end);
+            }
+
+            long long rows, cols, nnz;
+            const char *lineStop = nextLine(p, end);
+            if (!parseNumber(p, lineStop, rows) || !parseNumber(p, lineStop, cols) || !parseNumber(p, lineStop, nnz)) {
+                throw std::runtime_error("Malformed Matrix Market size line");
+            }
+            declaredVertices = std::max(rows, cols);
+            declaredEdges = nnz;
+            return static_cast<size_t>(lineStop - data);
+        }
+
+        if (format == EdgeFileFormat::DIMACS) {
+            while (p < end) {
+                const char *lineEnd = nextLine(p, end);
+                if (*p == 'p') {
+                    // "p sp <n> <m>": skip the problem keyword, then read sizes
+                    const char *q = p + 1;
+                    while (q < lineEnd && isBlank(*q)) q++;
+                    while (q < lineEnd && !isBlank(*q) && *q != '\n') q++;
+                    if (!parseNumber(q, lineEnd, declaredVertices) || !parseNumber(q, lineEnd, declaredEdges)) {
+                        throw std::runtime_error("Malformed DIMACS problem line");
+                    }
+                    result.weighted = true;
+                    return static_cast<size_t>(lineEnd - data);
+                }
+                if (*p == 'a') {
+                    break;
+                }
+                p = lineEnd;
+            }
+            return static_cast<size_t>(p - data);
+        }
+
+        return 0;
+    }
+
+public:
+    // Load an edge list. Text formats are split at line boundaries and parsed by
+    // `numThreads` workers (0 = hardware concurrency).
+    static EdgeList load(const std::string &path, EdgeFileFormat format = EdgeFileFormat::Auto,
+                         bool binaryWeighted = false, unsigned numThreads = 0)
+    {
+        MappedFile file(path);
+        const char *data = file.data();
+        size_t size = file.size();
+
+        if (format == EdgeFileFormat::Auto) {
+            format = detectFormat(path, data, size);
+        }
+
+        EdgeList result;
+
+        if (format == EdgeFileFormat::Binary) {
+            size_t recordInts = binaryWeighted ? 3 : 2;
+            size_t recordBytes = recordInts * sizeof(int32_t);
+            if (size % recordBytes != 0) {
+                throw std::runtime_error("Binary edge file size is not a multiple of the record size");
+            }
+
+            size_t m = size / recordBytes;
+            result.weighted = binaryWeighted;
+            result.sources.resize(m);
+            result.targets.resize(m);
+            if (binaryWeighted) {
+                result.weights.resize(m);
+            }
+
+            int maxVertex = -1;
+            for (size_t e = 0; e < m; e++) {
+                int32_t record[3];
+                std::memcpy(record, data + e * recordBytes, recordBytes);
+                result.sources[e] = record[0];
+                result.targets[e] = record[1];
+                if (binaryWeighted) {
+                    result.weights[e] = record[2];
+                }
+                if (record[0] < 0 || record[1] < 0) {
+                    throw std::runtime_error("Negative vertex id in binary edge file");
+                }
+                if (record[0] == std::numeric_limits<int32_t>::max() || record[1] == std::numeric_limits<int32_t>::max()) {
+                    throw std::runtime_error("Vertex id out of range in binary edge file");
+                }
+                maxVertex = std::max(maxVertex, static_cast<int>(std::max(record[0], record[1])));
+            }
+            result.numVertices = maxVertex + 1;
+            return result;
+        }
+
+        long long declaredVertices, declaredEdges;
+        size_t dataStart = parseHeader(format, data, size, result, declaredVertices, declaredEdges);
+        if (declaredVertices > std::numeric_limits<int>::max()) {
+            throw std::runtime_error("Edge file declares more vertices than fit in an int: " +
+                                     std::to_string(declaredVertices));
+        }
+
+        // Split the body into chunks aligned on line starts
+        if (numThreads == 0) {
+            numThreads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        const size_t minChunkBytes = 1 << 20;
+        size_t body = size - dataStart;
+        numThreads = static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(numThreads, body / minChunkBytes)));
+
+        std::vector<const char *> bounds(numThreads + 1);
+        bounds[0] = data + dataStart;
+        bounds[numThreads] = data + size;
+        for (unsigned t = 1; t < numThreads; t++) {
+            const char *guess = data + dataStart + body * t / numThreads;
+            bounds[t] = std::max(bounds[t - 1], guess == data + dataStart ? guess : nextLine(guess - 1, data + size));
+        }
+
+        std::vector<ChunkResult> chunks(numThreads);
+        std::vector<std::thread> workers;
+        auto parse = [&](unsigned t) {
+            try {
+                parseChunk(bounds[t], bounds[t + 1], format, chunks[t]);
+            } catch (...) {
+                chunks[t].error = std::current_exception();
+            }
+        };
+        for (unsigned t = 1; t < numThreads; t++) {
+            workers.emplace_back(parse, t);
+        }
+        parse(0);
+        for (std::thread &worker : workers) {
+            worker.join();
+        }
+        for (const ChunkResult &chunk : chunks) {
+            if (chunk.error) {
+                std::rethrow_exception(chunk.error);
+            }
+        }
+
+        // Concatenate per-chunk results in file order
+        size_t total = 0;
+        int maxVertex = -1;
+        bool sawWeight = false;
+        for (const ChunkResult &chunk : chunks) {
+            total += chunk.sources.size();
+            maxVertex = std::max(maxVertex, chunk.maxVertex);
+            sawWeight = sawWeight || chunk.sawWeight;
+        }
+
+        result.weighted = result.weighted || sawWeight;
+        result.sources.reserve(total);
+        result.targets.reserve(total);
+        if (result.weighted) {
+            result.weights.reserve(total);
+        }
+        for (ChunkResult &chunk : chunks) {
+            result.sources.insert(result.sources.end(), chunk.sources.begin(), chunk.sources.end());
+            result.targets.insert(result.targets.end(), chunk.targets.begin(), chunk.targets.end());
+            if (result.weighted) {
+                result.weights.insert(result.weights.end(), chunk.weights.begin(), chunk.weights.end());
+            }
+            chunk = ChunkResult();
+        }
+
+        result.numVertices = static_cast<int>(std::max<long long>(declaredVertices, maxVertex + 1));
+        return result;
+    }
+};
+
+//-------------------- CSR BUILDER --------------------
+// Build CSR arrays from an edge list with a counting sort on the source vertex.
+// - symmetrize: also insert (v, u) for every (u, v), e.g. for undirected graphs
+// - dedupe: sort each row and drop repeated targets (the first weight wins)
+inline CSRData buildCSR(const EdgeList &edges, bool symmetrize, bool dedupe = true)
+{
+    CSRData csr;
+    int n = edges.numVertices;
+    size_t m = edges.numEdges();
+    bool weighted = !edges.weights.empty();
+
+    csr.numVertices = n;
+    csr.offsets.assign(n + 1, 0);
+
+    for (size_t e = 0; e < m; e++) {
+        csr.offsets[edges.sources[e] + 1]++;
+        if (symmetrize && edges.sources[e] != edges.targets[e]) {
+            csr.offsets[edges.targets[e] + 1]++;
+        }
+    }
+    for (int v = 0; v < n; v++) {
+        csr.offsets[v + 1] += csr.offsets[v];
+    }
+
+    csr.targets.resize(csr.offsets[n]);
+    if (weighted) {
+        csr.weights.resize(csr.offsets[n]);
+    }
+
+    std::vector<int64_t> cursor(csr.offsets.begin(), csr.offsets.end() - 1);
+    for (size_t e = 0; e < m; e++) {
+        int u = edges.sources[e], v = edges.targets[e];
+        int64_t slot = cursor[u]++;
+        csr.targets[slot] = v;
+        if (weighted) {
+            csr.weights[slot] = edges.weights[e];
+        }
+        if (symmetrize && u != v) {
+            slot = cursor[v]++;
+            csr.targets[slot] = u;
+            if (weighted) {
+                csr.weights[slot] = edges.weights[e];
+            }
+        }
+    }
+
+    if (!dedupe) {
+        return csr;
+    }
+
+    // Sort each row (stable, so the first weight wins) and compact duplicates in place
+    std::vector<std::pair<int, int>> row;
+    int64_t write = 0;
+    for (int u = 0; u < n; u++) {
+        int64_t begin = csr.offsets[u], end = csr.offsets[u + 1];
+        row.clear();
+        for (int64_t i = begin; i < end; i++) {
+            row.push_back({csr.targets[i], weighted ? csr.weights[i] : 0});
+        }
+        std::stable_sort(row.begin(), row.end(),
+                         [](const std::pair<int, int> &a, const std::pair<int, int> &b) { return a.first < b.first; });
+
+        csr.offsets[u] = write;
+        for (size_t i = 0; i < row.size(); i++) {
+            if (i > 0 && row[i].first == row[i - 1].first) {
+                continue;
+            }
+            csr.targets[write] = row[i].first;
+            if (weighted) {
+                csr.weights[write] = row[i].second;
+            }
+            write++;
+        }
+    }
+    csr.offsets[n] = write;
+    csr.targets.resize(write);
+    if (weighted) {
+        csr.weights.resize(write);
+    }
+
+    return csr;
+}
+
+//-------------------- BINARY GRAPH FORMAT --------------------
+// Versioned on-disk CSR layout, little-endian, every section 64-byte aligned:
+//
+//   [0, 64)        BinaryGraphHeader
+//   offsetsPos     int64  offsets[numVertices + 1]
+//   targetsPos     int32  targets[numEdges]
+//   weightsPos     int32  weights[numEdges]      (only when FLAG_WEIGHTED)
+//
+// The checksum covers the first 56 header bytes and everything after the header,
+// so a file loaded through MappedBinaryGraph can be used in place without parsing.
+struct BinaryGraphHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint64_t numVertices;
+    uint64_t numEdges;
+    uint64_t offsetsPos;
+    uint64_t targetsPos;
+    uint64_t weightsPos;
+    uint64_t checksum;
+
+    static constexpr char MAGIC[8] = {'M', 'G', 'R', 'A', 'P', 'H', 'B', '\0'};
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint32_t FLAG_DIRECTED = 1u << 0;
+    static constexpr uint32_t FLAG_WEIGHTED = 1u << 1;
+    static constexpr uint64_t ALIGNMENT = 64;
+};
+
+static_assert(sizeof(BinaryGraphHeader) == 64, "BinaryGraphHeader must stay 64 bytes");
+
+inline bool hostIsLittleEndian()
+{
+    const uint16_t probe = 1;
+    unsigned char first;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+// 64-bit FNV-1a style hash over 8-byte words (tail bytes folded in one at a time)
+inline uint64_t graphChecksum(const char *data, size_t size, uint64_t hash = 14695981039346656037ull)
+{
+    const uint64_t prime = 1099511628211ull;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        hash = (hash ^ word) * prime;
+    }
+    for (; i < size; i++) {
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * prime;
+    }
+    return hash;
+}
+
+// Serialize CSR arrays into the binary graph format
+inline void writeBinaryGraph(const std::string &path, const CSRView &csr, bool isDirected)
+{
+    if (!hostIsLittleEndian()) {
+        throw std::runtime_error("Binary graph format is only written on little-endian hosts");
+    }
+
+    auto align = [](uint64_t pos) {
+        return (pos + BinaryGraphHeader::ALIGNMENT - 1) / BinaryGraphHeader::ALIGNMENT * BinaryGraphHeader::ALIGNMENT;
+    };
+
+    BinaryGraphHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, BinaryGraphHeader::MAGIC, sizeof(header.magic));
+    header.version = BinaryGraphHeader::VERSION;
+    header.flags = (isDirected ? BinaryGraphHeader::FLAG_DIRECTED : 0) |
+                   (csr.weights ? BinaryGraphHeader::FLAG_WEIGHTED : 0);
+    header.numVertices = static_cast<uint64_t>(csr.numVertices);
+    header.numEdges = static_cast<uint64_t>(csr.numEdges);
+    header.offsetsPos = align(sizeof(BinaryGraphHeader));
+    header.targetsPos = align(header.offsetsPos + (header.numVertices + 1) * sizeof(int64_t));
+    uint64_t end = header.targetsPos + header.numEdges * sizeof(int32_t);
+    if (csr.weights) {
+        header.weightsPos = align(end);
+        end = header.weightsPos + header.numEdges * sizeof(int32_t);
+    }
+
+    // Assemble the payload in memory so the checksum can be computed in one pass
+    std::vector<char> payload(end - sizeof(BinaryGraphHeader), 0);
+    char *base = payload.data() - sizeof(BinaryGraphHeader);
+    std::memcpy(base + header.offsetsPos, csr.offsets, (header.numVertices + 1) * sizeof(int64_t));
+    if (header.numEdges > 0) {
+        std::memcpy(base + header.targetsPos, csr.targets, header.numEdges * sizeof(int32_t));
+        if (csr.weights) {
+            std::memcpy(base + header.weightsPos, csr.weights, header.numEdges * sizeof(int32_t));
+        }
+    }
+
+    header.checksum = graphChecksum(payload.data(), payload.size(),
+                                    graphChecksum(reinterpret_cast<const char *>(&header), offsetof(BinaryGraphHeader, checksum)));
+
+    FILE *f = std::fopen(path.c_str(), "wb");
+    if (!f) {
+        throw std::runtime_error("Cannot create file: " + path);
+    }
+    bool ok = std::fwrite(&header, sizeof(header), 1, f) == 1 &&
+              std::fwrite(payload.data(), 1, payload.size(), f) == payload.size();
+    ok = (std::fclose(f) == 0) && ok;
+    if (!ok) {
+        throw std::runtime_error("Cannot write file: " + path);
+    }
+}
+
+// A binary graph file mapped into memory. The CSR view points straight into the
+// mapping; the header, section bounds, checksum, offsets and targets are
+// validated on open.
+class MappedBinaryGraph
+{
+private:
+    MappedFile file;
+    BinaryGraphHeader header;
+
+public:
+    explicit MappedBinaryGraph(const std::string &path, bool verifyChecksum = true) : file(path)
+    {
+        if (!hostIsLittleEndian()) {
+            throw std::runtime_error("Binary graph format can only be mapped on little-endian hosts");
+        }
+        if (file.size() < sizeof(BinaryGraphHeader)) {
+            throw std::runtime_error("File too small for a binary graph: " + path);
+        }
+
+        std::memcpy(&header, file.data(), sizeof(header));
+        if (std::memcmp(header.magic, BinaryGraphHeader::MAGIC, sizeof(header.magic)) != 0) {
+            throw std::runtime_error("Not a binary graph file: " + path);
+        }
+        if (header.version != BinaryGraphHeader::VERSION) {
+            throw std::runtime_error("Unsupported binary graph version " + std::to_string(header.version));
+        }
+
+        // Reject sizes that would not fit in the file before touching any section.
+        // Every position is bounded by the file size and the counts by what the
+        // file could hold, so none of the sums below can wrap around.
+        const uint64_t size = file.size();
+        const uint64_t intMax = static_cast<uint64_t>(std::numeric_limits<int>::max());
+        bool weighted = (header.flags & BinaryGraphHeader::FLAG_WEIGHTED) != 0;
+        bool valid = header.numVertices < intMax && header.numEdges <= size / sizeof(int32_t) &&
+                     header.offsetsPos <= size && header.targetsPos <= size && header.weightsPos <= size &&
+                     header.offsetsPos % BinaryGraphHeader::ALIGNMENT == 0 &&
+                     header.targetsPos % BinaryGraphHeader::ALIGNMENT == 0 &&
+                     header.offsetsPos >= sizeof(BinaryGraphHeader) &&
+                     header.offsetsPos + (header.numVertices + 1) * sizeof(int64_t) <= header.targetsPos &&
+                     header.targetsPos + header.numEdges * sizeof(int32_t) <= size;
+        if (valid && weighted) {
+            valid = header.weightsPos % BinaryGraphHeader::ALIGNMENT == 0 &&
+                    header.weightsPos >= header.targetsPos + header.numEdges * sizeof(int32_t) &&
+                    header.weightsPos + header.numEdges * sizeof(int32_t) <= size;
+        }
+        if (!valid) {
+            throw std::runtime_error("Corrupted binary graph header: " + path);
+        }
+
+        if (verifyChecksum) {
+            uint64_t checksum = graphChecksum(file.data() + sizeof(header), file.size() - sizeof(header),
+                                              graphChecksum(file.data(), offsetof(BinaryGraphHeader, checksum)));
+            if (checksum != header.checksum) {
+                throw std::runtime_error("Checksum mismatch in binary graph file: " + path);
+            }
+        }
+
+        // Offsets must be monotone and end at numEdges, and targets must name
+        // vertices, otherwise rows would index out of range. Checked even when
+        // the checksum is skipped, since a well-formed checksum proves nothing
+        // about a crafted file.
+        CSRView csr = view();
+        bool monotone = csr.offsets[0] == 0 && csr.offsets[csr.numVertices] == csr.numEdges;
+        for (int v = 0; monotone && v < csr.numVertices; v++) {
+            monotone = csr.offsets[v] <= csr.offsets[v + 1];
+        }
+        if (!monotone) {
+            throw std::runtime_error("Corrupted offsets in binary graph file: " + path);
+        }
+        for (int64_t e = 0; e < csr.numEdges; e++) {
+            if (csr.targets[e] < 0 || csr.targets[e] >= csr.numVertices) {
+                throw std::runtime_error("Corrupted targets in binary graph file: " + path);
+            }
+        }
+    }
+
+    bool isDirected() const
+    {
+        return (header.flags & BinaryGraphHeader::FLAG_DIRECTED) != 0;
+    }
+
+    CSRView view() const
+    {
+        CSRView view;
+        view.numVertices = static_cast<int>(header.numVertices);
+        view.numEdges = static_cast<int64_t>(header.numEdges);
+        view.offsets = reinterpret_cast<const int64_t *>(file.data() + header.offsetsPos);
+        view.targets = reinterpret_cast<const int *>(file.data() + header.targetsPos);
+        view.weights = (header.flags & BinaryGraphHeader::FLAG_WEIGHTED)
+                           ? reinterpret_cast<const int *>(file.data() + header.weightsPos)
+                           : nullptr;
+        return view;
+    }
+};
+
+//-------------------- EXTERNAL EDGE FILES --------------------
+// Streaming access to raw binary edge files ((u, v) int32 records, the unweighted
+// EdgeFileFormat::Binary layout) that are too large to load: reads go through a
+// caller-sized buffer with large sequential freads, and sortEdgeFile orders a
+// file by (source, target) with a bounded amount of memory.
+struct EdgeRecord
+{
+    int32_t source;
+    int32_t target;
+
+    bool operator<(const EdgeRecord &other) const
+    {
+        return source != other.source ? source < other.source : target < other.target;
+    }
+
+    bool operator==(const EdgeRecord &other) const
+    {
+        return source == other.source && target == other.target;
+    }
+};
+
+static_assert(sizeof(EdgeRecord) == 8, "EdgeRecord must match the binary edge file layout");
+
+class EdgeFileReader
+{
+private:
+    FILE *file = nullptr;
+    std::vector<EdgeRecord> buffer;
+    int64_t numRecords = 0;
+    int64_t bytesRead = 0;
+
+public:
+    EdgeFileReader(const std::string &path, size_t blockBytes = size_t(64) << 20)
+        : buffer(std::max<size_t>(1, blockBytes / sizeof(EdgeRecord)))
+    {
+        file = std::fopen(path.c_str(), "rb");
+        if (!file) {
+            throw std::runtime_error("Cannot open file: " + path);
+        }
+        std::setvbuf(file, nullptr, _IONBF, 0); // Blocks are already large; skip stdio's copy
+
+        std::fseek(file, 0, SEEK_END);
+        int64_t size = tell();
+        std::rewind(file);
+        if (size < 0 || size % static_cast<int64_t>(sizeof(EdgeRecord)) != 0) {
+            std::fclose(file);
+            throw std::runtime_error("Binary edge file size is not a multiple of the record size: " + path);
+        }
+        numRecords = size / static_cast<int64_t>(sizeof(EdgeRecord));
+    }
+
+    ~EdgeFileReader()
+    {
+        if (file) {
+            std::fclose(file);
+        }
+    }
+
+    EdgeFileReader(const EdgeFileReader &) = delete;
+    EdgeFileReader &operator=(const EdgeFileReader &) = delete;
+
+    int64_t size() const
+    {
+        return numRecords;
+    }
+
+    // Total bytes fetched from disk so far
+    int64_t totalBytesRead() const
+    {
+        return bytesRead;
+    }
+
+    int64_t tell() const
+    {
+#ifdef _WIN32
+        return _ftelli64(file);
+#else
+        return static_cast<int64_t>(ftello(file));
+#endif
+    }
+
+    // Position the next read at record `index`
+    void seek(int64_t index)
+    {
+        int64_t offset = index * static_cast<int64_t>(sizeof(EdgeRecord));
+#ifdef _WIN32
+        int status = _fseeki64(file, offset, SEEK_SET);
+#else
+        int status = fseeko(file, static_cast<off_t>(offset), SEEK_SET);
+#endif
+        if (status != 0) {
+            throw std::runtime_error("Cannot seek in binary edge file");
+        }
+    }
+
+    // Read up to one block (at most `limit` records) from the current position.
+    // Returns the number of records now in data(); 0 at the end of the file.
+    size_t readBlock(int64_t limit = std::numeric_limits<int64_t>::max())
+    {
+        size_t want = static_cast<size_t>(std::min<int64_t>(limit, static_cast<int64_t>(buffer.size())));
+        size_t got = std::fread(buffer.data(), sizeof(EdgeRecord), want, file);
+        if (got < want && std::ferror(file)) {
+            throw std::runtime_error("Cannot read binary edge file");
+        }
+        bytesRead += static_cast<int64_t>(got * sizeof(EdgeRecord));
+        return got;
+    }
+
+    const EdgeRecord *data() const
+    {
+        return buffer.data();
+    }
+
+    // Call fn(records, count) for every block of the range [begin, end)
+    template <class Fn>
+    void forEachBlock(int64_t begin, int64_t end, Fn fn)
+    {
+        seek(begin);
+        while (begin < end) {
+            size_t count = readBlock(end - begin);
+            if (count == 0) {
+                throw std::runtime_error("Unexpected end of binary edge file");
+            }
+            fn(data(), count);
+            begin += static_cast<int64_t>(count);
+        }
+    }
+};
+
+// Write an edge list as raw (u, v) int32 records
+inline void writeEdgeFile(const std::string &path, const EdgeList &edges)
+{
+    FILE *f = std::fopen(path.c_str(), "wb");
+    if (!f) {
+        throw std::runtime_error("Cannot create file: " + path);
+    }
+
+    std::vector<EdgeRecord> block;
+    bool ok = true;
+    for (size_t e = 0; e < edges.numEdges() && ok; e += block.size()) {
+        block.clear();
+        for (size_t i = e; i < edges.numEdges() && block.size() < (size_t(1) << 16); i++) {
+            block.push_back({edges.sources[i], edges.targets[i]});
+        }
+        ok = std::fwrite(block.data(), sizeof(EdgeRecord), block.size(), f) == block.size();
+    }
+    ok = (std::fclose(f) == 0) && ok;
+    if (!ok) {
+        throw std::runtime_error("Cannot write file: " + path);
+    }
+}
+
+// External merge sort of a binary edge file by (source, target), dropping
+// duplicate records. With `symmetrize` every edge is also emitted reversed, so
+// the output holds both directions of an undirected graph. At most
+// `memoryBytes` of records are held at once: the input is cut into sorted runs
+// of that size (written next to the output), which are then merged k-way with
+// one read buffer per run.
+inline void sortEdgeFile(const std::string &input, const std::string &output, bool symmetrize = false,
+                         size_t memoryBytes = size_t(256) << 20)
+{
+    size_t runRecords = std::max<size_t>(2, memoryBytes / sizeof(EdgeRecord));
+
+    // Run files are removed on every exit path, including a failed write or merge
+    struct RunFiles : std::vector<std::string>
+    {
+        ~RunFiles()
+        {
+            for (const std::string &run : *this) {
+                std::remove(run.c_str());
+            }
+        }
+    } runs;
+
+    auto writeRun = [](const std::string &path, const std::vector<EdgeRecord> &records) {
+        FILE *f = std::fopen(path.c_str(), "wb");
+        if (!f) {
+            throw std::runtime_error("Cannot create file: " + path);
+        }
+        bool ok = std::fwrite(records.data(), sizeof(EdgeRecord), records.size(), f) == records.size();
+        ok = (std::fclose(f) == 0) && ok;
+        if (!ok) {
+            throw std::runtime_error("Cannot write file: " + path);
+        }
+    };
+
+    {
+        EdgeFileReader reader(input, std::min<size_t>(memoryBytes / 2, size_t(64) << 20));
+        std::vector<EdgeRecord> run;
+        run.reserve(runRecords);
+        auto flush = [&]() {
+            std::sort(run.begin(), run.end());
+            run.erase(std::unique(run.begin(), run.end()), run.end());
+            runs.push_back(output + ".run" + std::to_string(runs.size()));
+            writeRun(runs.back(), run);
+            run.clear();
+        };
+
+        for (size_t count = reader.readBlock(); count > 0; count = reader.readBlock()) {
+            for (size_t i = 0; i < count; i++) {
+                const EdgeRecord &record = reader.data()[i];
+                if (record.source < 0 || record.target < 0) {
+                    throw std::runtime_error("Negative vertex id in binary edge file");
+                }
+                run.push_back(record);
+                if (symmetrize && record.source != record.target) {
+                    run.push_back({record.target, record.source});
+                }
+                if (run.size() + 1 >= runRecords) {
+                    flush();
+                }
+            }
+        }
+        if (!run.empty() || runs.empty()) {
+            flush();
+        }
+    }
+
+    // Merge the runs; each reader gets an equal share of the memory budget
+    size_t share = std::max<size_t>(size_t(1) << 16, memoryBytes / (runs.size() + 1));
+    std::vector<std::unique_ptr<EdgeFileReader>> readers;
+    std::vector<size_t> position, available;
+    using Head = std::pair<EdgeRecord, size_t>;
+    auto later = [](const Head &a, const Head &b) { return b.first < a.first; };
+    std::priority_queue<Head, std::vector<Head>, decltype(later)> heads(later);
+
+    for (size_t r = 0; r < runs.size(); r++) {
+        readers.emplace_back(new EdgeFileReader(runs[r], share));
+        position.push_back(0);
+        available.push_back(readers[r]->readBlock());
+        if (available[r] > 0) {
+            heads.push({readers[r]->data()[0], r});
+        }
+    }
+
+    FILE *out = std::fopen(output.c_str(), "wb");
+    if (!out) {
+        throw std::runtime_error("Cannot create file: " + output);
+    }
+    // A merge that throws (a run that cannot be read back) leaves no partial output
+    struct OutputGuard
+    {
+        FILE *&file;
+        const std::string &path;
+        ~OutputGuard()
+        {
+            if (file) {
+                std::fclose(file);
+                std::remove(path.c_str());
+            }
+        }
+    } outputGuard {out, output};
+    std::vector<EdgeRecord> pending;
+    pending.reserve(share / sizeof(EdgeRecord));
+    bool ok = true;
+    bool any = false;
+    EdgeRecord last = {0, 0};
+
+    while (!heads.empty() && ok) {
+        Head head = heads.top();
+        heads.pop();
+        if (!any || !(head.first == last)) {
+            pending.push_back(head.first);
+            last = head.first;
+            any = true;
+            if (pending.size() == pending.capacity()) {
+                ok = std::fwrite(pending.data(), sizeof(EdgeRecord), pending.size(), out) == pending.size();
+                pending.clear();
+            }
+        }
+
+        size_t r = head.second;
+        if (++position[r] == available[r]) {
+            position[r] = 0;
+            available[r] = readers[r]->readBlock();
+        }
+        if (position[r] < available[r]) {
+            heads.push({readers[r]->data()[position[r]], r});
+        }
+    }
+    if (ok && !pending.empty()) {
+        ok = std::fwrite(pending.data(), sizeof(EdgeRecord), pending.size(), out) == pending.size();
+    }
+    ok = (std::fclose(out) == 0) && ok;
+    out = nullptr;
+
+    if (!ok) {
+        throw std::runtime_error("Cannot write file: " + output);
+    }
+}
+
+//-------------------- DISTANCE ARITHMETIC --------------------
+// Path lengths for algorithms templated on the distance type (int32_t, int64_t,
+// float or double). Integer types take their maximum as infinity and add with
+// saturation: a sum that would overflow becomes infinity (or the lowest value
+// when it runs off below), never a wrapped-around small number. Floating
+// types use IEEE infinity and plain addition.
+template <class Distance>
+struct DistanceTraits
+{
+    static_assert(std::is_arithmetic<Distance>::value, "Distances must be an arithmetic type");
+
+    static constexpr Distance infinity()
+    {
+        return std::numeric_limits<Distance>::has_infinity ? std::numeric_limits<Distance>::infinity()
+                                                           : std::numeric_limits<Distance>::max();
+    }
+
+    // distance + weight; infinity stays infinity
+    static Distance add(Distance distance, Distance weight)
+    {
+        if constexpr (std::is_integral<Distance>::value) {
+            if (distance == infinity()) {
+                return infinity();
+            }
+            if constexpr (sizeof(Distance) < sizeof(int64_t)) {
+                // Exact in 64 bits, then clamped without a branch
+                int64_t sum = (int64_t)distance + weight;
+                return (Distance)std::min<int64_t>(std::max<int64_t>(sum, std::numeric_limits<Distance>::lowest()),
+                                                   infinity());
+            } else {
+#if defined(__GNUC__) || defined(__clang__)
+                Distance sum;
+                if (__builtin_add_overflow(distance, weight, &sum)) {
+                    return weight > 0 ? infinity() : std::numeric_limits<Distance>::lowest();
+                }
+                return sum;
+#else
+                if (weight > 0 && distance > std::numeric_limits<Distance>::max() - weight) {
+                    return infinity();
+                }
+                if (weight < 0 && distance < std::numeric_limits<Distance>::lowest() - weight) {
+                    return std::numeric_limits<Distance>::lowest();
+                }
+                return distance + weight;
+#endif
+            }
+        } else {
+            return distance + weight;
+        }
+    }
+};
+
+#endif // GRAPH_IO_H